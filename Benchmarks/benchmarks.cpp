@@ -0,0 +1,312 @@
+#include "date_time.hpp"
+#include "batch.hpp"
+#include "timestamp_stream.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using namespace mt;
+using namespace mt::time;
+using namespace mt::date;
+using namespace mt::date_time;
+
+namespace {
+    /**
+     * \brief Number of distinct inputs each benchmark cycles through, so results are not computed once and cached by the compiler or branch predictor.
+     */
+    constexpr std::size_t inputs_count{1024};
+    /**
+     * \brief Number of rows batch benchmarks process per iteration.
+     */
+    constexpr std::size_t batch_rows{1 << 18};
+
+    auto maxThreads() -> int { return static_cast< int >(std::max(std::thread::hardware_concurrency(), 1U)); }
+
+    auto dateTimes(const std::size_t p_count) -> std::vector< DateTime > {
+        std::mt19937_64 engine{42};
+        // 1900-01-01T00:00:00Z - 2100-01-01T00:00:00Z.
+        std::uniform_int_distribution< int64_t > since_epoch{-2'208'988'800'000'000'000, 4'102'444'800'000'000'000};
+        std::uniform_int_distribution< int > offset{-12, 12};
+        std::vector< DateTime > result;
+        result.reserve(p_count);
+        for (std::size_t i = 0; i < p_count; ++i) {
+            result.emplace_back(std::chrono::nanoseconds{since_epoch(engine)}, static_cast< TimeZone >(offset(engine)));
+        }
+        return result;
+    }
+
+    template < class Value, class Function >
+    auto strings(const std::vector< Value >& p_values, Function&& p_function) -> std::vector< std::string > {
+        std::vector< std::string > result;
+        result.reserve(p_values.size());
+        for (const auto& value: p_values) {
+            result.emplace_back(p_function(value));
+        }
+        return result;
+    }
+
+    const std::vector< DateTime > date_times{dateTimes(inputs_count)};
+
+    auto dates() -> std::vector< Date > {
+        std::vector< Date > result;
+        result.reserve(date_times.size());
+        for (const auto& date_time: date_times) {
+            result.emplace_back(date_time.date());
+        }
+        return result;
+    }
+
+    auto times() -> std::vector< Time > {
+        std::vector< Time > result;
+        result.reserve(date_times.size());
+        for (const auto& date_time: date_times) {
+            result.emplace_back(date_time.time());
+        }
+        return result;
+    }
+
+    /**
+     * \brief Returns p_time in [HH:MM:SS.mmm.mmm.nnn+(-)HH] format, the longest one string constructors accept.
+     */
+    auto timeString(const Time& p_time) -> std::string {
+        std::array< char, 32 > buffer{};
+        const auto offset = static_cast< int >(p_time.utcOffset().count() / 3600);
+        const auto length = std::snprintf(buffer.data(),
+                                          buffer.size(),
+                                          "%02d:%02d:%02d.%03d.%03d.%03d%c%02d",
+                                          static_cast< int >(p_time.hours().count()),
+                                          static_cast< int >(p_time.minutes().count()),
+                                          static_cast< int >(p_time.seconds().count()),
+                                          static_cast< int >(p_time.milliseconds().count()),
+                                          static_cast< int >(p_time.microseconds().count()),
+                                          static_cast< int >(p_time.nanoseconds().count()),
+                                          offset < 0 ? '-' : '+',
+                                          std::abs(offset));
+        return std::string{buffer.data(), static_cast< std::size_t >(length)};
+    }
+
+    auto dateTimeString(const DateTime& p_date_time) -> std::string { return p_date_time.date().toString() + 'T' + timeString(p_date_time.time()); }
+
+    const std::vector< Date > date_values{dates()};
+    const std::vector< Time > time_values{times()};
+    const std::vector< std::string > date_strings{strings(date_values, [](const Date& p_date) { return p_date.toString(); })};
+    const std::vector< std::string > time_strings{strings(time_values, timeString)};
+    const std::vector< std::string > date_time_strings{strings(date_times, dateTimeString)};
+
+    template < class Value >
+    void stringConstructor(benchmark::State& p_state, const std::vector< std::string >& p_strings) {
+        std::size_t i{0};
+        for (auto _: p_state) {
+            Value value{p_strings[i++ % p_strings.size()]};
+            benchmark::DoNotOptimize(value);
+        }
+        p_state.SetItemsProcessed(p_state.iterations());
+    }
+
+    template < class Value >
+    void toString(benchmark::State& p_state, const std::vector< Value >& p_values) {
+        std::size_t i{0};
+        for (auto _: p_state) {
+            auto result = p_values[i++ % p_values.size()].toString();
+            benchmark::DoNotOptimize(result);
+        }
+        p_state.SetItemsProcessed(p_state.iterations());
+    }
+
+    /**
+     * \brief Applies operator+ with Variant holding alternative of index Alternative, so the variant dispatch is measured as well.
+     */
+    template < class Value, class Variant, std::size_t Alternative >
+    void add(benchmark::State& p_state, const std::vector< Value >& p_values) {
+        std::size_t i{0};
+        const Variant duration{std::in_place_index< Alternative >, 3};
+        for (auto _: p_state) {
+            auto result = p_values[i++ % p_values.size()] + duration;
+            benchmark::DoNotOptimize(result);
+        }
+        p_state.SetItemsProcessed(p_state.iterations());
+    }
+
+    /**
+     * \brief Applies operator- with Variant holding alternative of index Alternative, so the variant dispatch is measured as well.
+     */
+    template < class Value, class Variant, std::size_t Alternative >
+    void subtract(benchmark::State& p_state, const std::vector< Value >& p_values) {
+        std::size_t i{0};
+        const Variant duration{std::in_place_index< Alternative >, 3};
+        for (auto _: p_state) {
+            auto result = p_values[i++ % p_values.size()] - duration;
+            benchmark::DoNotOptimize(result);
+        }
+        p_state.SetItemsProcessed(p_state.iterations());
+    }
+
+    template < class Value >
+    void compare(benchmark::State& p_state, const std::vector< Value >& p_values) {
+        std::size_t i{0};
+        for (auto _: p_state) {
+            const auto& l = p_values[i % p_values.size()];
+            const auto& r = p_values[(i + 1) % p_values.size()];
+            ++i;
+            benchmark::DoNotOptimize(l < r);
+            benchmark::DoNotOptimize(l == r);
+        }
+        p_state.SetItemsProcessed(p_state.iterations());
+    }
+
+    template < class Value, class Accessor >
+    void access(benchmark::State& p_state, const std::vector< Value >& p_values, Accessor p_accessor) {
+        std::size_t i{0};
+        for (auto _: p_state) {
+            auto result = p_accessor(p_values[i++ % p_values.size()]);
+            benchmark::DoNotOptimize(result);
+        }
+        p_state.SetItemsProcessed(p_state.iterations());
+    }
+
+    void localDateTime(benchmark::State& p_state) {
+        for (auto _: p_state) {
+            auto result = DateTime::localDateTime();
+            benchmark::DoNotOptimize(result);
+        }
+        p_state.SetItemsProcessed(p_state.iterations());
+    }
+
+    auto batchInput() -> const std::vector< DateTime >& {
+        static const auto input = dateTimes(batch_rows);
+        return input;
+    }
+
+    auto batchStrings() -> const std::vector< std::string >& {
+        static const auto input = strings(batchInput(), dateTimeString);
+        return input;
+    }
+
+    /**
+     * \brief Formats batch_rows date times with executor of range(0) threads.
+     */
+    void batchFormat(benchmark::State& p_state) {
+        batch::Executor executor{static_cast< std::size_t >(p_state.range(0))};
+        const auto& input = batchInput();
+        std::vector< char > buffer(batch::formattedDateTimesLength(input.size()));
+        std::vector< int64_t > offsets(input.size() + 1);
+        for (auto _: p_state) {
+            benchmark::DoNotOptimize(batch::formatDateTimes(executor, input, buffer, offsets));
+            benchmark::ClobberMemory();
+        }
+        p_state.SetItemsProcessed(p_state.iterations() * static_cast< int64_t >(input.size()));
+    }
+
+    /**
+     * \brief Parses batch_rows date time strings with executor of range(0) threads.
+     */
+    void batchParse(benchmark::State& p_state) {
+        batch::Executor executor{static_cast< std::size_t >(p_state.range(0))};
+        const auto& strings = batchStrings();
+        const std::vector< std::string_view > input{strings.begin(), strings.end()};
+        std::vector< std::chrono::year_month_day > dates(input.size());
+        std::vector< std::chrono::nanoseconds > times(input.size());
+        std::vector< TimeZone > offsets(input.size());
+        std::vector< uint64_t > validity(batch::validityWords(input.size()));
+        const batch::DateTimeColumns output{dates, times, offsets, validity};
+        if (batch::parseDateTimes(executor, input, output) != input.size()) {
+            p_state.SkipWithError("Input is not parsed");
+            return;
+        }
+        for (auto _: p_state) {
+            benchmark::DoNotOptimize(batch::parseDateTimes(executor, input, output));
+            benchmark::ClobberMemory();
+        }
+        p_state.SetItemsProcessed(p_state.iterations() * static_cast< int64_t >(input.size()));
+    }
+
+    /**
+     * \brief Decodes batch_rows regular millisecond ticks from TimestampStream.
+     */
+    void streamDecode(benchmark::State& p_state) {
+        batch::TimestampStream stream;
+        for (std::size_t i = 0; i < batch_rows; ++i) {
+            stream.append(1'709'249'400'000'000'000 + static_cast< int64_t >(i) * 1'000'000);
+        }
+        std::vector< int64_t > output(stream.size());
+        for (auto _: p_state) {
+            stream.decode(0, output);
+            benchmark::ClobberMemory();
+        }
+        p_state.SetItemsProcessed(p_state.iterations() * static_cast< int64_t >(output.size()));
+        p_state.counters["bytes_per_row"] = static_cast< double >(stream.bytes()) / static_cast< double >(stream.size());
+    }
+
+    /**
+     * \brief Registers add and subtract benchmarks for each alternative of Variant, p_alternatives holds their names.
+     */
+    template < class Value, class Variant >
+    void registerArithmetic(const std::string& p_name, const std::vector< Value >& p_values, const std::array< const char*, std::variant_size_v< Variant > >& p_alternatives) {
+        [&]< std::size_t... Alternatives >(std::index_sequence< Alternatives... >) {
+            (benchmark::RegisterBenchmark((p_name + "/Add/" + p_alternatives[Alternatives]).c_str(), add< Value, Variant, Alternatives >, p_values), ...);
+            (benchmark::RegisterBenchmark((p_name + "/Subtract/" + p_alternatives[Alternatives]).c_str(), subtract< Value, Variant, Alternatives >, p_values), ...);
+        }(std::make_index_sequence< std::variant_size_v< Variant > >{});
+    }
+
+    template < class Value, class Accessor >
+    void registerAccessor(const char* p_name, const std::vector< Value >& p_values, Accessor p_accessor) {
+        benchmark::RegisterBenchmark(p_name, access< Value, Accessor >, p_values, p_accessor);
+    }
+
+    void registerBenchmarks() {
+        benchmark::RegisterBenchmark("Date/StringConstructor", stringConstructor< Date >, date_strings)->ThreadRange(1, maxThreads());
+        benchmark::RegisterBenchmark("Time/StringConstructor", stringConstructor< Time >, time_strings)->ThreadRange(1, maxThreads());
+        benchmark::RegisterBenchmark("DateTime/StringConstructor", stringConstructor< DateTime >, date_time_strings)->ThreadRange(1, maxThreads());
+
+        benchmark::RegisterBenchmark("Date/ToString", toString< Date >, date_values)->ThreadRange(1, maxThreads());
+        benchmark::RegisterBenchmark("Time/ToString", toString< Time >, time_values)->ThreadRange(1, maxThreads());
+        benchmark::RegisterBenchmark("DateTime/ToString", toString< DateTime >, date_times)->ThreadRange(1, maxThreads());
+
+        registerArithmetic< Date, DateDuration >("Date", date_values, {"days", "months", "years"});
+        registerArithmetic< Time, TimeDuration >("Time", time_values, {"hours", "minutes", "seconds", "milliseconds", "microseconds", "nanoseconds"});
+        registerArithmetic< DateTime, DateDuration >("DateTime", date_times, {"days", "months", "years"});
+        registerArithmetic< DateTime, TimeDuration >("DateTime", date_times, {"hours", "minutes", "seconds", "milliseconds", "microseconds", "nanoseconds"});
+
+        registerAccessor("Date/Year", date_values, [](const Date& p_date) { return p_date.year(); });
+        registerAccessor("Date/Month", date_values, [](const Date& p_date) { return p_date.month(); });
+        registerAccessor("Date/MonthDay", date_values, [](const Date& p_date) { return p_date.monthDay(); });
+        registerAccessor("Date/WeekDay", date_values, [](const Date& p_date) { return p_date.weekDay(); });
+        registerAccessor("Time/Hours", time_values, [](const Time& p_time) { return p_time.hours(); });
+        registerAccessor("Time/Minutes", time_values, [](const Time& p_time) { return p_time.minutes(); });
+        registerAccessor("Time/Seconds", time_values, [](const Time& p_time) { return p_time.seconds(); });
+        registerAccessor("Time/Milliseconds", time_values, [](const Time& p_time) { return p_time.milliseconds(); });
+        registerAccessor("Time/Microseconds", time_values, [](const Time& p_time) { return p_time.microseconds(); });
+        registerAccessor("Time/Nanoseconds", time_values, [](const Time& p_time) { return p_time.nanoseconds(); });
+        registerAccessor("DateTime/SinceEpoch", date_times, [](const DateTime& p_date_time) { return p_date_time.sinceEpoch(); });
+
+        benchmark::RegisterBenchmark("Date/Compare", compare< Date >, date_values);
+        benchmark::RegisterBenchmark("Time/Compare", compare< Time >, time_values);
+        benchmark::RegisterBenchmark("DateTime/Compare", compare< DateTime >, date_times);
+
+        benchmark::RegisterBenchmark("DateTime/LocalDateTime", localDateTime)->ThreadRange(1, maxThreads());
+
+        benchmark::RegisterBenchmark("Batch/FormatDateTimes", batchFormat)->RangeMultiplier(2)->Range(1, maxThreads())->UseRealTime();
+        benchmark::RegisterBenchmark("Batch/ParseDateTimes", batchParse)->RangeMultiplier(2)->Range(1, maxThreads())->UseRealTime();
+        benchmark::RegisterBenchmark("Batch/TimestampStreamDecode", streamDecode);
+    }
+}  // End of unnamed namespace
+
+int main(int argc, char** argv) {
+    registerBenchmarks();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
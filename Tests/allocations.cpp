@@ -0,0 +1,240 @@
+#include "date_time.hpp"
+#include "batch.hpp"
+#include "epoch.hpp"
+#include "packed_date_time.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace mt;
+using namespace mt::time;
+using namespace mt::date;
+using namespace mt::date_time;
+
+namespace {
+    /**
+     * \brief Number of calls of replaced allocation functions made by all threads.
+     */
+    std::atomic< std::size_t > allocations{0};
+
+    auto allocate(std::size_t p_size) noexcept -> void* {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(p_size == 0 ? 1 : p_size);
+    }
+
+    auto allocate(std::size_t p_size, const std::align_val_t p_alignment) noexcept -> void* {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        const auto alignment = static_cast< std::size_t >(p_alignment);
+        // aligned_alloc requires the size to be a multiple of the alignment.
+        return std::aligned_alloc(alignment, (std::max< std::size_t >(p_size, 1) + alignment - 1) / alignment * alignment);
+    }
+
+#if defined(__GNUC__) && not defined(__clang__)
+  // GCC does not know that replaced operator new allocates with malloc, so it reports free of every inlined delete as mismatched.
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+    void deallocate(void* const p_pointer) noexcept { std::free(p_pointer); }
+#if defined(__GNUC__) && not defined(__clang__)
+  #pragma GCC diagnostic pop
+#endif
+
+    /**
+     * \brief Returns number of allocations p_function makes.
+     * p_function is called once before counting, so lazily initialized statics and thread locals are not counted.
+     */
+    template < class Function >
+    auto countAllocations(Function&& p_function) -> std::size_t {
+        p_function();
+        const auto before = allocations.load(std::memory_order_relaxed);
+        p_function();
+        return allocations.load(std::memory_order_relaxed) - before;
+    }
+}  // End of unnamed namespace
+
+auto operator new(const std::size_t p_size) -> void* {
+    if (auto* const pointer = allocate(p_size)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+auto operator new[](const std::size_t p_size) -> void* { return operator new(p_size); }
+
+auto operator new(const std::size_t p_size, const std::nothrow_t&) noexcept -> void* { return allocate(p_size); }
+
+auto operator new[](const std::size_t p_size, const std::nothrow_t&) noexcept -> void* { return allocate(p_size); }
+
+auto operator new(const std::size_t p_size, const std::align_val_t p_alignment) -> void* {
+    if (auto* const pointer = allocate(p_size, p_alignment)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+auto operator new[](const std::size_t p_size, const std::align_val_t p_alignment) -> void* { return operator new(p_size, p_alignment); }
+
+auto operator new(const std::size_t p_size, const std::align_val_t p_alignment, const std::nothrow_t&) noexcept -> void* { return allocate(p_size, p_alignment); }
+
+auto operator new[](const std::size_t p_size, const std::align_val_t p_alignment, const std::nothrow_t&) noexcept -> void* { return allocate(p_size, p_alignment); }
+
+void operator delete(void* const p_pointer) noexcept { deallocate(p_pointer); }
+
+void operator delete[](void* const p_pointer) noexcept { deallocate(p_pointer); }
+
+void operator delete(void* const p_pointer, std::size_t) noexcept { deallocate(p_pointer); }
+
+void operator delete[](void* const p_pointer, std::size_t) noexcept { deallocate(p_pointer); }
+
+void operator delete(void* const p_pointer, const std::nothrow_t&) noexcept { deallocate(p_pointer); }
+
+void operator delete[](void* const p_pointer, const std::nothrow_t&) noexcept { deallocate(p_pointer); }
+
+void operator delete(void* const p_pointer, std::align_val_t) noexcept { deallocate(p_pointer); }
+
+void operator delete[](void* const p_pointer, std::align_val_t) noexcept { deallocate(p_pointer); }
+
+void operator delete(void* const p_pointer, std::size_t, std::align_val_t) noexcept { deallocate(p_pointer); }
+
+void operator delete[](void* const p_pointer, std::size_t, std::align_val_t) noexcept { deallocate(p_pointer); }
+
+void operator delete(void* const p_pointer, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(p_pointer); }
+
+void operator delete[](void* const p_pointer, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(p_pointer); }
+
+TEST(Allocations, Hooks) {
+    // New expression may be elided, allocation function called directly may not.
+    ASSERT_EQ(countAllocations([] { ::operator delete(::operator new(sizeof(int))); }), 1) << "Allocation functions are not replaced";
+}
+
+TEST(Allocations, Date) {
+    const Date date{std::chrono::year{2024}, std::chrono::February, std::chrono::day{29}};
+    const Date other{std::chrono::year{2024}, std::chrono::March, std::chrono::day{1}};
+    Date result;
+    bool less{false};
+    ASSERT_EQ(countAllocations([&] { less = date < other && not(date == other) && date <= other; }), 0);
+    ASSERT_TRUE(less);
+    ASSERT_EQ(countAllocations([&] { result = date + DateDuration{std::chrono::days{1}}; }), 0);
+    ASSERT_EQ(result, other);
+    ASSERT_EQ(countAllocations([&] { result = date + DateDuration{std::chrono::months{1}}; }), 0);
+    ASSERT_EQ(countAllocations([&] { result = date - DateDuration{std::chrono::years{1}}; }), 0);
+    ASSERT_EQ(countAllocations([&] { result += DateDuration{std::chrono::months{1}}; }), 0);
+    ASSERT_EQ(countAllocations([&] { result = date + std::chrono::days{1}; }), 0);
+
+    int64_t fields{0};
+    ASSERT_EQ(countAllocations([&] { fields = date.year< int32_t >() + date.month< int32_t >() + date.monthDay< int32_t >() + date.weekDay< int32_t >(); }), 0);
+    ASSERT_EQ(fields, 2024 + 2 + 29 + 4);
+    ASSERT_EQ(countAllocations([&] { fields = date.isWeekend() ? 1 : 0; }), 0);
+
+    ASSERT_EQ(countAllocations([&] { result = Date::tryParse("2024-02-29").value_or(Date{}); }), 0);
+    ASSERT_EQ(result, date);
+    ASSERT_EQ(countAllocations([&] { fields = Date::tryParse("2024-02-30").has_value() ? 1 : 0; }), 0);
+
+    std::array< char, Date::max_string_length > buffer{};
+    ASSERT_EQ(countAllocations([&] { static_cast< void >(date.toChars(buffer.data(), buffer.data() + buffer.size())); }), 0);
+    ASSERT_LE(countAllocations([&] { static_cast< void >(date.toString()); }), 1);
+}
+
+TEST(Allocations, Time) {
+    const Time time{std::chrono::hours{13}, std::chrono::minutes{45}, std::chrono::seconds{10}};
+    const Time other{std::chrono::hours{14}, std::chrono::minutes{0}};
+    Time result;
+    bool less{false};
+    ASSERT_EQ(countAllocations([&] { less = time < other && not(time == other) && time <= other; }), 0);
+    ASSERT_TRUE(less);
+    for (const auto& duration: std::array< TimeDuration, 6 >{std::chrono::hours{1},
+                                                             std::chrono::minutes{1},
+                                                             std::chrono::seconds{1},
+                                                             std::chrono::milliseconds{1},
+                                                             std::chrono::microseconds{1},
+                                                             std::chrono::nanoseconds{1}}) {
+        ASSERT_EQ(countAllocations([&] { result = time + duration; }), 0);
+        ASSERT_EQ(countAllocations([&] { result = time - duration; }), 0);
+        ASSERT_EQ(countAllocations([&] { result += duration; }), 0);
+    }
+    ASSERT_EQ(countAllocations([&] { result = time + other; }), 0);
+
+    int64_t fields{0};
+    ASSERT_EQ(countAllocations([&] {
+                  fields = time.hours().count() + time.minutes().count() + time.seconds().count() + time.milliseconds().count() + time.microseconds().count()
+                         + time.nanoseconds().count();
+              }),
+              0);
+    ASSERT_EQ(fields, 13 + 45 + 10);
+
+    ASSERT_EQ(countAllocations([&] { result = Time::tryParse("13:45:10").value_or(Time{std::chrono::nanoseconds{0}, TimeZone::UTC}); }), 0);
+    ASSERT_EQ(result, time);
+    ASSERT_EQ(countAllocations([&] { fields = Time::tryParse("25:00:00").has_value() ? 1 : 0; }), 0);
+
+    std::array< char, 32 > buffer{};
+    ASSERT_EQ(countAllocations([&] { static_cast< void >(time.toChars(buffer.data(), buffer.data() + buffer.size())); }), 0);
+    ASSERT_LE(countAllocations([&] { static_cast< void >(time.toString()); }), 1);
+}
+
+TEST(Allocations, DateTime) {
+    const DateTime date_time{Date{std::chrono::year{2024}, std::chrono::February, std::chrono::day{29}}, Time{std::chrono::hours{23}, std::chrono::minutes{30}}};
+    const DateTime other{std::chrono::nanoseconds{0}};
+    DateTime result;
+    bool less{false};
+    ASSERT_EQ(countAllocations([&] { less = other < date_time && not(other == date_time) && other <= date_time; }), 0);
+    ASSERT_TRUE(less);
+    for (const auto& duration: std::array< DateDuration, 3 >{std::chrono::days{1}, std::chrono::months{1}, std::chrono::years{1}}) {
+        ASSERT_EQ(countAllocations([&] { result = date_time + duration; }), 0);
+        ASSERT_EQ(countAllocations([&] { result = date_time - duration; }), 0);
+        ASSERT_EQ(countAllocations([&] { result += duration; }), 0);
+    }
+    for (const auto& duration: std::array< TimeDuration, 6 >{std::chrono::hours{1},
+                                                             std::chrono::minutes{1},
+                                                             std::chrono::seconds{1},
+                                                             std::chrono::milliseconds{1},
+                                                             std::chrono::microseconds{1},
+                                                             std::chrono::nanoseconds{1}}) {
+        ASSERT_EQ(countAllocations([&] { result = date_time + duration; }), 0);
+        ASSERT_EQ(countAllocations([&] { result = date_time - duration; }), 0);
+        ASSERT_EQ(countAllocations([&] { result -= duration; }), 0);
+    }
+
+    std::chrono::nanoseconds since_epoch{0};
+    ASSERT_EQ(countAllocations([&] { since_epoch = date_time.sinceEpoch() + date_time.date().sinceEpoch().time_since_epoch() + date_time.time().sinceDayStart(); }), 0);
+    ASSERT_EQ(countAllocations([&] { result = PackedDateTime{date_time}.toDateTime(TimeZone::EAST_2); }), 0);
+
+    ASSERT_EQ(countAllocations([&] { result = DateTime::tryParse("2024-02-29T23:30:00").value_or(DateTime{}); }), 0);
+    ASSERT_EQ(result, date_time);
+    ASSERT_EQ(countAllocations([&] { less = DateTime::tryParse("2024-02-29 23:30:00").has_value(); }), 0);
+
+    std::array< char, DateTime::max_string_length > buffer{};
+    ASSERT_EQ(countAllocations([&] { static_cast< void >(date_time.toChars(buffer.data(), buffer.data() + buffer.size())); }), 0);
+    ASSERT_LE(countAllocations([&] { static_cast< void >(date_time.toString()); }), 1);
+}
+
+TEST(Allocations, Batch) {
+    const std::vector< DateTime > input(100, DateTime{std::chrono::nanoseconds{1'709'249'400'000'000'000}});
+    std::vector< char > buffer(batch::formattedDateTimesLength(input.size()));
+    std::vector< int64_t > offsets(input.size() + 1);
+    ASSERT_EQ(countAllocations([&] { static_cast< void >(batch::formatDateTimes(input, buffer, offsets)); }), 0);
+
+    const std::vector< std::string_view > strings(input.size(), "2024-02-29T23:30:00.250+03");
+    std::vector< std::chrono::year_month_day > dates(input.size());
+    std::vector< std::chrono::nanoseconds > times(input.size());
+    std::vector< TimeZone > zones(input.size());
+    std::vector< uint64_t > validity(batch::validityWords(input.size()));
+    std::size_t valid{0};
+    ASSERT_EQ(countAllocations([&] { valid = batch::parseDateTimes(strings, {dates, times, zones, validity}); }), 0);
+    ASSERT_EQ(valid, input.size());
+
+    std::vector< int64_t > epoch(input.size(), 1'709'249'400);
+    std::vector< int32_t > years(input.size());
+    std::vector< uint8_t > months(input.size());
+    std::vector< uint8_t > days(input.size());
+    std::vector< int64_t > since_day_start(input.size());
+    const batch::CivilColumns civil{years, months, days, since_day_start};
+    ASSERT_EQ(countAllocations([&] { batch::epochToCivil(epoch, batch::EpochUnit::Seconds, civil); }), 0);
+    ASSERT_EQ(countAllocations([&] { batch::civilToEpoch(civil, batch::EpochUnit::Seconds, epoch); }), 0);
+    ASSERT_EQ(epoch.front(), 1'709'249'400);
+}
@@ -1,12 +1,43 @@
 #ifndef TESTS_HPP
 #define TESTS_HPP
 #include "date_time.hpp"
+#include "batch.hpp"
+#include "literals.hpp"
+#include "timestamp_cache.hpp"
+#include "coarse_clock.hpp"
+#include "packed_date_time.hpp"
+#include "sort.hpp"
+#include "date_time_column.hpp"
+#include "epoch.hpp"
+#include "business_calendar.hpp"
+#include "recurrence.hpp"
+#include "date_range.hpp"
+#include "zone_database.hpp"
+#include "zone_conversion.hpp"
+#include "instrumentation.hpp"
+#include "timestamp_stream.hpp"
 
 #include <gtest/gtest.h>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <thread>
 using namespace mt;
 using namespace mt::time;
 using namespace mt::date;
 using namespace mt::date_time;
+using namespace mt::literals;
+
+namespace {
+    /**
+     * \brief Returns date time with random day in [p_first_day, p_first_day + p_days) days since 1970-01-01 and random time of the day.
+     */
+    auto randomDateTime(std::mt19937_64& p_engine, const int64_t p_first_day, const int64_t p_days, const TimeZone p_offset) -> DateTime {
+        const std::chrono::days days{std::uniform_int_distribution< int64_t >{p_first_day, p_first_day + p_days - 1}(p_engine)};
+        const std::chrono::nanoseconds since_day_start{std::uniform_int_distribution< int64_t >{0, std::chrono::nanoseconds{std::chrono::days{1}}.count() - 1}(p_engine)};
+        return DateTime{Date{std::chrono::sys_days{days}}, Time{since_day_start, p_offset}};
+    }
+}  // End of unnamed namespace
 
 TEST(Time, Default_constructor) {
     const Time time;
@@ -447,4 +478,1021 @@ TEST(Date, OperatorPlusMinus) {
     ASSERT_EQ(date.monthDay(), std::chrono::day{31});
 }
 
+TEST(Date, TryParse) {
+    const auto date = Date::tryParse("2024-02-29");
+    ASSERT_TRUE(date.has_value());
+    ASSERT_EQ(date->date(), std::chrono::year{2024} / std::chrono::February / std::chrono::day{29});
+    ASSERT_EQ(Date::tryParse("20240229"), date);
+
+    ASSERT_EQ(Date::tryParse("2024-02-3").error(), (parser::Error{parser::ErrorCode::InvalidLength, 9}));
+    ASSERT_EQ(Date::tryParse("2024/02/29").error(), (parser::Error{parser::ErrorCode::InvalidCharacter, 4}));
+    ASSERT_EQ(Date::tryParse("2024-0a-29").error(), (parser::Error{parser::ErrorCode::InvalidCharacter, 6}));
+    ASSERT_EQ(Date::tryParse("2024-13-01").error(), (parser::Error{parser::ErrorCode::InvalidMonth, 5}));
+    ASSERT_EQ(Date::tryParse("2023-02-29").error(), (parser::Error{parser::ErrorCode::InvalidDay, 8}));
+    ASSERT_EQ(Date::tryParse("20240431").error(), (parser::Error{parser::ErrorCode::InvalidDay, 6}));
+}
+
+TEST(Time, TryParse) {
+    const auto time = Time::tryParse("23:23:23.023.023.023+02");
+    ASSERT_TRUE(time.has_value());
+    ASSERT_EQ(*time, Time{std::string{"23:23:23.023.023.023+02"}});
+    ASSERT_EQ(time->offset(), TimeZone::EAST_2);
+    ASSERT_EQ(Time::tryParse("23:23-05")->offset(), TimeZone::WEST_5);
+    ASSERT_EQ(Time::tryParse("23:23:23-05:00")->offset(), TimeZone::WEST_5);
+    ASSERT_EQ(Time::tryParse("23:23:23.023Z")->milliseconds().count(), 23);
+
+    ASSERT_EQ(Time::tryParse("23:23:23.0023.023").error(), (parser::Error{parser::ErrorCode::InvalidLength, 17}));
+    ASSERT_EQ(Time::tryParse("2a:23").error(), (parser::Error{parser::ErrorCode::InvalidCharacter, 1}));
+    ASSERT_EQ(Time::tryParse("23:23:23:023").error(), (parser::Error{parser::ErrorCode::InvalidCharacter, 8}));
+    ASSERT_EQ(Time::tryParse("24:00").error(), (parser::Error{parser::ErrorCode::InvalidHours, 0}));
+    ASSERT_EQ(Time::tryParse("23:60").error(), (parser::Error{parser::ErrorCode::InvalidMinutes, 3}));
+    ASSERT_EQ(Time::tryParse("23:59:60").error(), (parser::Error{parser::ErrorCode::InvalidSeconds, 6}));
+    ASSERT_EQ(Time::tryParse("23:59+13").error(), (parser::Error{parser::ErrorCode::InvalidOffset, 5}));
+}
+
+TEST(DateTime, TryParse) {
+    const auto date_time = DateTime::tryParse("2024-02-29T13:45:00.250+03");
+    ASSERT_TRUE(date_time.has_value());
+    ASSERT_EQ(date_time->date(), Date{std::string{"2024-02-29"}});
+    ASSERT_EQ(date_time->time(), Time{std::string{"13:45:00.250"}});
+    ASSERT_EQ(date_time->time().offset(), TimeZone::EAST_3);
+    ASSERT_TRUE(DateTime::tryParse("20240229T13:45").has_value());
+
+    ASSERT_EQ(DateTime::tryParse("2024-02-29 13:45").error(), (parser::Error{parser::ErrorCode::InvalidCharacter, 10}));
+    ASSERT_EQ(DateTime::tryParse("2024-02-29T13:45:0").error(), (parser::Error{parser::ErrorCode::InvalidLength, 18}));
+    ASSERT_EQ(DateTime::tryParse("2024-02-30T13:45").error(), (parser::Error{parser::ErrorCode::InvalidDay, 8}));
+    ASSERT_EQ(DateTime::tryParse("2024-02-29T13:75").error(), (parser::Error{parser::ErrorCode::InvalidMinutes, 14}));
+}
+
+TEST(DateTime, ParseFast) {
+    const std::vector< std::string > valid{
+        "2024-02-29T13:45",
+        "20240229T13:45:00",
+        "2024-02-29T13:45:00.250",
+        "2024-02-29T13:45:00.250.125",
+        "2024-02-29T13:45:00.250.125.999",
+        "2024-02-29T13:45:00.250.125.999Z",
+        "2024-02-29T13:45:00.250.125.999+12",
+        "2024-02-29T13:45:00.250.125.999-11:00",
+        "99991231T23:59:59.999.999.999-12:00",
+        "00000101T00:00Z",
+    };
+    std::vector< std::string > inputs = valid;
+    for (const auto& input: valid) {
+        for (std::size_t i = 0; i < input.length(); ++i) {
+            for (const char replacement: {'x', '0', '9', '-', ':', '\0'}) {
+                auto mutated = input;
+                mutated[i] = replacement;
+                inputs.push_back(mutated);
+            }
+        }
+        inputs.push_back(input.substr(0, input.length() - 1));
+        inputs.push_back(input + "0");
+    }
+    for (const auto& input: inputs) {
+        const auto expected = parser::parseDateTime(input);
+        for (const auto instruction_set: {InstructionSet::Scalar, InstructionSet::SSE42, InstructionSet::AVX2}) {
+            const auto result = parser::parseDateTimeFast(input, instruction_set);
+            ASSERT_EQ(result.has_value(), expected.has_value()) << input;
+            if (expected) {
+                ASSERT_EQ(result->date, expected->date) << input;
+                ASSERT_EQ(result->time.since_day_start, expected->time.since_day_start) << input;
+                ASSERT_EQ(result->time.offset, expected->time.offset) << input;
+            } else {
+                ASSERT_EQ(result.error(), expected.error()) << input;
+            }
+        }
+    }
+}
+
+TEST(Batch, ParseDateTimes) {
+    std::vector< std::string_view > input;
+    for (std::size_t i = 0; i < 130; ++i) {
+        input.emplace_back(i % 3 == 0 ? "2024-02-30T13:45" : "2024-02-29T13:45:00.250+03");
+    }
+    std::vector< std::chrono::year_month_day > dates(input.size());
+    std::vector< std::chrono::nanoseconds > times(input.size());
+    std::vector< TimeZone > offsets(input.size());
+    std::vector< uint64_t > validity(batch::validityWords(input.size()));
+
+    const auto valid_rows = batch::parseDateTimes(input, batch::DateTimeColumns{dates, times, offsets, validity});
+    ASSERT_EQ(valid_rows, 86);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        ASSERT_EQ(batch::isValid(validity, i), i % 3 != 0);
+        if (i % 3 != 0) {
+            ASSERT_EQ(dates[i], std::chrono::year{2024} / std::chrono::February / std::chrono::day{29});
+            ASSERT_EQ(times[i], std::chrono::hours{13} + std::chrono::minutes{45} + std::chrono::milliseconds{250});
+            ASSERT_EQ(offsets[i], TimeZone::EAST_3);
+        } else {
+            ASSERT_EQ(dates[i], std::chrono::year_month_day{});
+        }
+    }
+    std::vector< uint64_t > short_validity(1);
+    EXPECT_THROW(batch::parseDateTimes(input, batch::DateTimeColumns{dates, times, offsets, short_validity}), std::invalid_argument);
+}
+
+TEST(Batch, ParseBuffer) {
+    const std::string_view buffer = "2024-01-0120240229x23:5923:59:59.999+01";
+    const std::vector< int64_t > date_offsets{0, 10, 18, 19};
+    std::vector< std::chrono::year_month_day > dates(3);
+    std::vector< uint64_t > validity(1);
+    ASSERT_EQ(batch::parseDates(buffer, date_offsets, batch::DateColumns{dates, validity}), 2);
+    ASSERT_EQ(validity[0], 0b011);
+    ASSERT_EQ(dates[1], std::chrono::year{2024} / std::chrono::February / std::chrono::day{29});
+
+    const std::vector< int64_t > time_offsets{19, 24, 39};
+    std::vector< std::chrono::nanoseconds > times(2);
+    std::vector< TimeZone > offsets(2);
+    ASSERT_EQ(batch::parseTimes(buffer, time_offsets, batch::TimeColumns{times, offsets, validity}), 2);
+    ASSERT_EQ(times[1], std::chrono::hours{23} + std::chrono::minutes{59} + std::chrono::seconds{59} + std::chrono::milliseconds{999});
+    ASSERT_EQ(offsets[1], TimeZone::EAST_1);
+
+    const std::vector< int64_t > bad_offsets{0, 10, 5};
+    EXPECT_THROW(batch::parseTimes(buffer, bad_offsets, batch::TimeColumns{times, offsets, validity}), std::invalid_argument);
+}
+
+TEST(Literals, CompileTime) {
+    constexpr Date dates[]{"2024-02-29"_date, "20240301"_date};
+    static_assert(dates[0].date() == std::chrono::year{2024} / std::chrono::February / std::chrono::day{29});
+    static_assert(dates[0] < dates[1]);
+    constexpr auto time = "13:45:00.250+02"_time;
+    static_assert(time.offset() == TimeZone::EAST_2);
+    static_assert("13:45"_time < time);
+    constexpr auto date_time = "2024-02-29T13:45:00Z"_dt;
+    static_assert(date_time.date() == dates[0]);
+    static_assert(date_time.time() == "13:45:00"_time);
+
+    ASSERT_EQ(time, Time{std::string{"13:45:00.250"}});
+    ASSERT_EQ(date_time.date(), Date{std::string{"2024-02-29"}});
+}
+
+TEST(FormatPattern, Format) {
+    constexpr FormatPattern pattern{"%Y/%m/%d %j %u %H.%M.%S.%3f %z %Ez %Z %%"};
+    static_assert(pattern.usesDate() && pattern.usesTime());
+    const auto date_time = "2024-02-29T13:45:07.250.125.999-05"_dt;
+    ASSERT_EQ(date_time.toString(pattern), "2024/02/29 060 4 13.45.07.250 -0500 -05:00 -05:00 %");
+    ASSERT_EQ(date_time.toString(), "2024-02-29T13:45:07.250125999-05:00");
+    ASSERT_EQ(date_time.date().toString(), "2024-02-29");
+    ASSERT_EQ(date_time.time().toString(), "13:45:07.250125999-05:00");
+    ASSERT_EQ("00:00Z"_time.toString(FormatPattern{"%T.%6f%Z"}), "00:00:00.000000Z");
+    ASSERT_EQ(Date{std::chrono::year{-42} / 1 / 1}.toString(FormatPattern{"%F"}), "-0042-01-01");
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    // Empty formatter falls back to the default format.
+    ASSERT_EQ(date_time.toString(std::function< std::string(const DateTime&) >{}), date_time.toString());
+    ASSERT_EQ(date_time.date().toString(std::function< std::string(const Date&) >{}), "2024-02-29");
+    ASSERT_EQ(date_time.time().toString(std::function< std::string(const Time&) >{}), "13:45:07.250125999-05:00");
+    ASSERT_EQ(date_time.date().toString([](const Date&) { return std::string{"date"}; }), "date");
+#pragma GCC diagnostic pop
+
+    char buffer[8];
+    const auto [end, error] = pattern.format(std::begin(buffer), std::end(buffer), date_time.date().date(), date_time.time().sinceDayStart(), date_time.time().offset());
+    ASSERT_EQ(error, std::errc::value_too_large);
+
+    EXPECT_THROW(FormatPattern{"%Q"}, std::invalid_argument);
+    EXPECT_THROW(FormatPattern{"%E"}, std::invalid_argument);
+    EXPECT_THROW(date_time.date().toString(FormatPattern{"%T"}), std::invalid_argument);
+    EXPECT_THROW(date_time.time().toString(FormatPattern{"%F"}), std::invalid_argument);
+}
+
+TEST(FormatPattern, ToChars) {
+    const auto date_time = "2024-02-29T13:45:07.250-05"_dt;
+    std::array< char, DateTime::max_string_length > buffer{};
+    const auto [end, error] = date_time.toChars(buffer.data(), buffer.data() + buffer.size());
+    ASSERT_EQ(error, std::errc{});
+    ASSERT_EQ(std::string_view(buffer.data(), end), "2024-02-29T13:45:07.250000000-05:00");
+    ASSERT_EQ(date_time.toChars(buffer.data(), buffer.data() + 10).ec, std::errc::value_too_large);
+    ASSERT_EQ(date_time.date().toChars(buffer.data(), buffer.data() + 10).ptr, buffer.data() + 10);
+    ASSERT_EQ(date_time.time().toChars(buffer.data(), buffer.data() + buffer.size(), FormatPattern{"%F"}).ec, std::errc::invalid_argument);
+
+    std::string out;
+    date_time.formatTo(std::back_inserter(out));
+    date_time.date().formatTo(std::back_inserter(out), FormatPattern{" %Y%m%d "});
+    date_time.time().formatTo(std::back_inserter(out));
+    ASSERT_EQ(out, "2024-02-29T13:45:07.250000000-05:00 20240229 13:45:07.250000000-05:00");
+
+    std::ostringstream stream;
+    stream << date_time << ' ' << date_time.date() << ' ' << date_time.time();
+    ASSERT_EQ(stream.str(), "2024-02-29T13:45:07.250000000-05:00 2024-02-29 13:45:07.250000000-05:00");
+}
+
+TEST(Batch, FormatDateTimes) {
+    std::vector< DateTime > input{"2024-02-29T13:45:07.250-05"_dt, "0001-01-01T00:00:00Z"_dt, "9999-12-31T23:59:59.999.999.999+12"_dt, "19700101T00:00:00.000.000.001-12"_dt};
+    std::mt19937_64 engine{7};
+    std::uniform_int_distribution< int > offsets_distribution{-12, 12};
+    while (input.size() < 200) {
+        input.push_back(randomDateTime(engine, 0, 3'000'000, static_cast< TimeZone >(offsets_distribution(engine))));
+    }
+    std::vector< char > buffer(batch::formattedDateTimesLength(input.size()));
+    std::vector< int64_t > offsets(input.size() + 1);
+    const auto length = batch::formatDateTimes(input, buffer, offsets);
+    ASSERT_EQ(length, static_cast< std::size_t >(offsets.back()));
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        ASSERT_EQ(std::string_view(buffer.data() + offsets[i], buffer.data() + offsets[i + 1]), input[i].toString()) << i;
+    }
+
+    const std::vector< int64_t > epoch{0, -1, 1'709'214'307'250'000'000, 9'223'372'036'854'775'807};
+    ASSERT_EQ(batch::formatDateTimes(epoch, buffer, offsets), 120);
+    ASSERT_EQ(std::string_view(buffer.data(), 120),
+              "1970-01-01T00:00:00.000000000Z1969-12-31T23:59:59.999999999Z2024-02-29T13:45:07.250000000Z2262-04-11T23:47:16.854775807Z");
+
+    ASSERT_THROW(batch::formatDateTimes(input, std::span{buffer}.first(10), offsets), std::invalid_argument);
+    ASSERT_THROW(batch::formatDateTimes(input, buffer, std::span{offsets}.first(10)), std::invalid_argument);
+}
+
+TEST(TimestampCache, Format) {
+    TimestampCache cache;
+    for (const auto& date_time: {"2024-02-29T13:45:07.250-05"_dt,
+                                 "2024-02-29T13:45:07.000.000.001-05"_dt,
+                                 "2024-02-29T13:45:07.999.999.999-05"_dt,
+                                 "2024-02-29T13:45:07.500Z"_dt,
+                                 "2024-02-29T13:45:08Z"_dt,
+                                 "2024-03-01T13:45:08.125Z"_dt,
+                                 "2024-03-01T13:45:08.125+03"_dt}) {
+        ASSERT_EQ(cache.format(date_time), date_time.toString());
+    }
+
+    const auto& local = TimestampCache::local();
+    ASSERT_EQ(&local, &TimestampCache::local());
+    TimestampCache now{TimeZone::EAST_3};
+    const auto before = DateTime{TimeZone::EAST_3};
+    const std::string first{now.now()};
+    const std::string second{now.now()};
+    const auto after = DateTime{TimeZone::EAST_3};
+    ASSERT_EQ(first.length(), before.toString().length());
+    ASSERT_LE(before.toString(), first);
+    ASSERT_LE(first, second);
+    ASSERT_LE(second, after.toString());
+}
+
+TEST(TimestampCache, LocalOffsetChange) {
+    const auto* const time_zone = std::getenv("TZ");
+    const std::string previous = time_zone == nullptr ? "" : time_zone;
+    setenv("TZ", "Asia/Tokyo", 1);
+    tzset();
+    refreshLocalOffset();
+    std::string before;
+    std::string after;
+    // Thread local cache is created in a new thread, so it starts with the offset set above.
+    std::thread{[&] {
+        before = TimestampCache::local().now();
+        setenv("TZ", "UTC", 1);
+        tzset();
+        refreshLocalOffset();
+        std::this_thread::sleep_for(std::chrono::milliseconds{1'100});
+        after = TimestampCache::local().now();
+    }}.join();
+    ASSERT_TRUE(before.ends_with("+09:00")) << before;
+    ASSERT_TRUE(after.ends_with("Z")) << after;
+
+    if (time_zone == nullptr) {
+        unsetenv("TZ");
+    } else {
+        setenv("TZ", previous.c_str(), 1);
+    }
+    tzset();
+    refreshLocalOffset();
+}
+
+TEST(CoarseClock, Now) {
+    ASSERT_FALSE(CoarseClock::isRunning());
+    ASSERT_THROW(CoarseClock::start(std::chrono::nanoseconds{0}), std::invalid_argument);
+    CoarseClock::start(std::chrono::milliseconds{1});
+    ASSERT_TRUE(CoarseClock::isRunning());
+    const auto before = std::chrono::system_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    const auto coarse = CoarseClock::now();
+    ASSERT_GT(coarse, before);
+    ASSERT_LE(coarse, std::chrono::system_clock::now());
+
+    const auto date_time = DateTime::now(ClockSource::Coarse, TimeZone::EAST_3);
+    ASSERT_EQ(date_time.time().offset(), TimeZone::EAST_3);
+    ASSERT_LE(date_time.toString(), DateTime::now(ClockSource::System, TimeZone::EAST_3).toString());
+    ASSERT_LE(Date::now(ClockSource::Coarse), Date::now());
+    ASSERT_EQ(Time::now(ClockSource::Coarse, TimeZone::WEST_2).offset(), TimeZone::WEST_2);
+
+    CoarseClock::stop();
+    ASSERT_FALSE(CoarseClock::isRunning());
+    ASSERT_GE(CoarseClock::now(), coarse);
+}
+
+TEST(TimeZone, LocalOffset) {
+    const auto* const time_zone = std::getenv("TZ");
+    const std::string previous = time_zone == nullptr ? "" : time_zone;
+    setenv("TZ", "Asia/Tokyo", 1);
+    tzset();
+    refreshLocalOffset();
+    ASSERT_EQ(localOffset(), TimeZone::EAST_9);
+    ASSERT_EQ(Time::localTime().offset(), TimeZone::EAST_9);
+    ASSERT_EQ(DateTime::localDateTime().time().offset(), TimeZone::EAST_9);
+
+    setenv("TZ", "UTC", 1);
+    tzset();
+    ASSERT_EQ(localOffset(), TimeZone::EAST_9);
+    refreshLocalOffset();
+    std::vector< std::thread > threads;
+    std::atomic< int > mismatches{0};
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&mismatches] {
+            for (int j = 0; j < 1000; ++j) {
+                mismatches += localOffset() != TimeZone::UTC;
+            }
+        });
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    ASSERT_EQ(mismatches, 0);
+
+    if (time_zone == nullptr) {
+        unsetenv("TZ");
+    } else {
+        setenv("TZ", previous.c_str(), 1);
+    }
+    tzset();
+    refreshLocalOffset();
+}
+
+TEST(PackedDateTime, Conversion) {
+    static_assert(sizeof(PackedDateTime) == 8);
+    static_assert(PackedDateTime{"1970-01-01T03:00:00+03"_dt}.sinceEpoch() == std::chrono::nanoseconds{0});
+    constexpr auto unpacked = PackedDateTime{"2024-02-29T13:45:07.000.000.001-05"_dt}.toDateTime(TimeZone::WEST_5);
+    static_assert(unpacked.time() == "13:45:07.000.000.001-05"_time);
+
+    const auto packed = PackedDateTime{"2024-02-29T13:45:07.250-05"_dt};
+    ASSERT_EQ(packed.sinceEpoch(), std::chrono::nanoseconds{1'709'232'307'250'000'000});
+    ASSERT_EQ(packed.toDateTime(), "2024-02-29T18:45:07.250Z"_dt);
+    ASSERT_EQ(packed.toDateTime(TimeZone::EAST_12), "2024-03-01T06:45:07.250+12"_dt);
+    ASSERT_EQ(PackedDateTime{packed.toDateTime(TimeZone::EAST_12)}, packed);
+    ASSERT_LT(PackedDateTime{"2024-02-29T13:45:07+03"_dt}, PackedDateTime{"2024-02-29T13:45:07Z"_dt});
+    ASSERT_EQ(std::hash< PackedDateTime >{}(packed), std::hash< int64_t >{}(packed.sinceEpoch().count()));
+
+    const PackedDateTime max{std::chrono::sys_time< std::chrono::nanoseconds >{std::chrono::nanoseconds::max()}};
+    ASSERT_EQ(max.toDateTime(TimeZone::EAST_12).toString(), "2262-04-12T11:47:16.854775807+12:00");
+    ASSERT_THROW(PackedDateTime{"2262-04-12T00:00:00Z"_dt}, std::range_error);
+    ASSERT_THROW(PackedDateTime{"1677-09-21T00:00:00Z"_dt}, std::range_error);
+}
+
+TEST(Batch, RadixSort) {
+    std::vector< int64_t > keys;
+    std::mt19937_64 engine{7};
+    while (keys.size() < 300'000) {
+        const auto value = static_cast< int64_t >(engine());
+        // Every third key is spread over the whole range, the rest repeat often.
+        keys.push_back(keys.size() % 3 == 0 ? value : value % 1'000'000);
+    }
+    std::vector< uint32_t > indices(keys.size());
+    std::iota(indices.begin(), indices.end(), uint32_t{0});
+    auto expected = keys;
+    std::ranges::stable_sort(expected);
+    batch::Executor executor{4};
+    for (const bool parallel: {false, true}) {
+        auto sorted = keys;
+        auto payload = indices;
+        if (parallel) {
+            batch::radixSort(executor, std::span{sorted}, std::span{payload});
+        } else {
+            batch::radixSort(std::span{sorted}, std::span{payload});
+        }
+        ASSERT_EQ(sorted, expected);
+        for (std::size_t i = 1; i < payload.size(); ++i) {
+            ASSERT_EQ(keys[payload[i]], sorted[i]);
+            if (sorted[i - 1] == sorted[i]) {
+                ASSERT_LT(payload[i - 1], payload[i]);
+            }
+        }
+    }
+
+    std::vector< DateTime > date_times{"2024-02-29T13:45:07.250-05"_dt, "2024-02-29T13:45:07.250Z"_dt, "1677-09-22T00:00:00Z"_dt, "2262-04-10T23:59:59.999.999.999Z"_dt,
+                                       "1969-12-31T23:59:59.999.999.999+03"_dt, "2024-02-29T00:00:00Z"_dt};
+    std::vector< uint32_t > order(date_times.size());
+    batch::sortedIndices(date_times, order);
+    ASSERT_EQ(order, (std::vector< uint32_t >{2, 4, 5, 0, 1, 3}));
+    batch::sortedIndices(executor, date_times, order);
+    ASSERT_EQ(order, (std::vector< uint32_t >{2, 4, 5, 0, 1, 3}));
+    batch::radixSort(std::span{date_times});
+    ASSERT_EQ(date_times[1], "1969-12-31T23:59:59.999.999.999+03"_dt);
+    ASSERT_EQ(date_times[4].time().offset(), TimeZone::UTC);
+    ASSERT_THROW((void)batch::sortKey("2262-04-11T00:00:00Z"_dt), std::range_error);
+
+    std::vector< PackedDateTime > packed{PackedDateTime{"2024-02-29T13:45:07Z"_dt}, PackedDateTime{"2024-02-29T13:45:07+03"_dt}, PackedDateTime{}};
+    batch::radixSort(std::span{packed});
+    ASSERT_TRUE(std::ranges::is_sorted(packed));
+    std::vector< PackedDateTime > many(300'000);
+    std::ranges::transform(keys, many.begin(), [](const int64_t p_key) {
+        return PackedDateTime{std::chrono::sys_time< std::chrono::nanoseconds >{std::chrono::nanoseconds{p_key}}};
+    });
+    batch::radixSort(executor, std::span{many});
+    ASSERT_TRUE(std::ranges::is_sorted(many));
+
+    const std::vector< int64_t > first{-5, 1, 3, 3, 9};
+    const std::vector< int64_t > second{-7, 3, 4, 10};
+    std::vector< int64_t > merged(first.size() + second.size());
+    batch::mergeSorted(first, second, merged);
+    ASSERT_EQ(merged, (std::vector< int64_t >{-7, -5, 1, 3, 3, 3, 4, 9, 10}));
+    ASSERT_THROW(batch::mergeSorted(first, second, std::span{merged}.first(3)), std::invalid_argument);
+}
+
+TEST(DateTimeColumn, Fields) {
+    std::vector< DateTime > date_times{"2024-02-29T13:45:07.250-05"_dt, "1970-01-01T00:00:00Z"_dt, "1969-12-31T23:59:59.999.999.999Z"_dt, "0000-03-01T12:00:00Z"_dt};
+    date_times.emplace_back(Date{std::chrono::year_month_day{std::chrono::year{-4713}, std::chrono::November, std::chrono::day{24}}}, Time{std::chrono::nanoseconds{1}, TimeZone::UTC});
+    std::mt19937_64 engine{7};
+    while (date_times.size() < 1'000) {
+        date_times.push_back(randomDateTime(engine, -3'000'000, 6'000'000, TimeZone::EAST_2));
+    }
+    const batch::DateTimeColumn column{date_times};
+    ASSERT_EQ(column.size(), date_times.size());
+    std::vector< int32_t > years(column.size());
+    std::vector< uint8_t > months(column.size());
+    std::vector< uint8_t > month_days(column.size());
+    std::vector< uint8_t > week_days(column.size());
+    std::vector< uint8_t > hours(column.size());
+    std::vector< uint8_t > minutes(column.size());
+    std::vector< uint8_t > seconds(column.size());
+    auto weekend = std::make_unique< bool[] >(column.size());
+    column.years(years);
+    column.months(months);
+    column.monthDays(month_days);
+    column.weekDays(week_days);
+    column.isWeekend({weekend.get(), column.size()});
+    column.hours(hours);
+    column.minutes(minutes);
+    column.seconds(seconds);
+    for (std::size_t i = 0; i < column.size(); ++i) {
+        const auto& date = date_times[i].date();
+        const auto& time = date_times[i].time();
+        ASSERT_EQ(column.at(i), date_times[i]);
+        ASSERT_EQ(years[i], static_cast< int32_t >(date.year())) << i;
+        ASSERT_EQ(months[i], static_cast< uint32_t >(date.month())) << i;
+        ASSERT_EQ(month_days[i], static_cast< uint32_t >(date.monthDay())) << i;
+        ASSERT_EQ(week_days[i], date.weekDay().c_encoding()) << i;
+        ASSERT_EQ(weekend[i], date.isWeekend()) << i;
+        ASSERT_EQ(hours[i], time.hours().count()) << i;
+        ASSERT_EQ(minutes[i], time.minutes().count()) << i;
+        ASSERT_EQ(seconds[i], time.seconds().count()) << i;
+    }
+    ASSERT_THROW(column.hours(std::span{hours}.first(3)), std::invalid_argument);
+    ASSERT_THROW((void)column.at(column.size()), std::out_of_range);
+
+    // Rows in IANA time zones keep exact offset and zone.
+    const auto kolkata = ZoneDatabase::locate("Asia/Kolkata");
+    const std::vector< DateTime > zoned{DateTime{"2024-06-01T00:00:00Z"_dt.sinceEpoch(), kolkata},
+                                        DateTime{"2024-06-01T00:00:00Z"_dt.sinceEpoch(), ZoneDatabase::locate("Pacific/Kiritimati")},
+                                        "2024-06-01T05:30:00+05"_dt};
+    const batch::DateTimeColumn zoned_column{zoned};
+    ASSERT_EQ(zoned_column.utcOffsets()[0], 19'800);
+    ASSERT_EQ(zoned_column.zones()[0], kolkata);
+    ASSERT_EQ(zoned_column.zones()[2], ZoneId::None);
+    for (std::size_t i = 0; i < zoned.size(); ++i) {
+        const auto row = zoned_column.at(i);
+        ASSERT_EQ(row, zoned[i]);
+        ASSERT_EQ(row.toString(), zoned[i].toString());
+        ASSERT_EQ(row.time().zone(), zoned[i].time().zone());
+        ASSERT_EQ(row.time().utcOffset(), zoned[i].time().utcOffset());
+        ASSERT_EQ(row.time().offset(), zoned[i].time().offset());
+        ASSERT_EQ(row.sinceEpoch(), zoned[i].sinceEpoch());
+    }
+}
+
+TEST(Batch, EpochToCivil) {
+    static_assert(batch::daysFromCivil({1970, 1, 1}) == 0);
+    static_assert(batch::civilFromDays(-719'468).year == 0 && batch::civilFromDays(-719'468).month == 3);
+    for (const auto unit: {batch::EpochUnit::Seconds, batch::EpochUnit::Milliseconds, batch::EpochUnit::Microseconds, batch::EpochUnit::Nanoseconds}) {
+        const auto ticks_per_day = batch::ticksPerDay(unit);
+        std::vector< int64_t > epoch{0, -1, 1, ticks_per_day - 1, ticks_per_day, -ticks_per_day, -ticks_per_day - 1, ticks_per_day * 106'000 + 1};
+        std::mt19937_64 engine{7};
+        while (epoch.size() < 5'000) {
+            const auto value = static_cast< int64_t >(engine());
+            epoch.push_back(value % (ticks_per_day * std::min< int64_t >(3'000'000, std::numeric_limits< int64_t >::max() / ticks_per_day)));
+        }
+        std::vector< int32_t > years(epoch.size());
+        std::vector< uint8_t > months(epoch.size());
+        std::vector< uint8_t > days(epoch.size());
+        std::vector< int64_t > since_day_start(epoch.size());
+        const batch::CivilColumns columns{years, months, days, since_day_start};
+        batch::epochToCivil(epoch, unit, columns);
+        for (std::size_t i = 0; i < epoch.size(); ++i) {
+            const auto day = epoch[i] / ticks_per_day - (epoch[i] % ticks_per_day < 0);
+            const std::chrono::year_month_day date{std::chrono::sys_days{std::chrono::days{day}}};
+            ASSERT_EQ(years[i], static_cast< int32_t >(date.year())) << i;
+            ASSERT_EQ(months[i], static_cast< uint32_t >(date.month())) << i;
+            ASSERT_EQ(days[i], static_cast< uint32_t >(date.day())) << i;
+            ASSERT_EQ(since_day_start[i], epoch[i] - day * ticks_per_day) << i;
+        }
+        std::vector< int64_t > round_trip(epoch.size());
+        batch::civilToEpoch(columns, unit, round_trip);
+        ASSERT_EQ(round_trip, epoch);
+        ASSERT_THROW(batch::epochToCivil(std::span{epoch}.first(10), unit, columns), std::invalid_argument);
+    }
+
+    const DateTime date_time{std::chrono::nanoseconds{1'709'232'307'250'000'000}, TimeZone::WEST_5};
+    ASSERT_EQ(date_time, "2024-02-29T13:45:07.250-05"_dt);
+    ASSERT_EQ(date_time.sinceEpoch(), std::chrono::nanoseconds{1'709'232'307'250'000'000});
+    ASSERT_EQ(DateTime{std::chrono::seconds{-1}}, "1969-12-31T23:59:59Z"_dt);
+}
+
+TEST(Date, DaySerial) {
+    constexpr Date leap_day{std::chrono::year{2024} / std::chrono::February / std::chrono::day{29}};
+    static_assert(leap_day.sinceEpoch().time_since_epoch() == std::chrono::days{19'782});
+    static_assert(leap_day.weekDay() == std::chrono::Thursday);
+    static_assert((leap_day + std::chrono::days{1}).date() == std::chrono::year{2024} / std::chrono::March / std::chrono::day{1});
+    static_assert(leap_day - Date{std::chrono::sys_days{}} == std::chrono::days{19'782});
+
+    const Date first{std::chrono::year{1900} / std::chrono::January / std::chrono::day{1}};
+    Date date = first;
+    for (int32_t i = 0; i < 100'000; ++i) {
+        ASSERT_EQ(date - first, std::chrono::days{i});
+        ASSERT_EQ(first - date, std::chrono::days{-i});
+        ASSERT_EQ(date.weekDay(), std::chrono::weekday{std::chrono::sys_days{date.date()}});
+        ASSERT_EQ(Date{date.date()}, date);
+        date += std::chrono::days{1};
+    }
+    ASSERT_EQ(date.date(), std::chrono::year_month_day{std::chrono::sys_days{first.date()} + std::chrono::days{100'000}});
+
+    ASSERT_TRUE(first < date);
+    ASSERT_TRUE(date > first);
+    ASSERT_FALSE(first > first);
+    ASSERT_TRUE(first >= first);
+    ASSERT_TRUE(first <= first);
+    ASSERT_TRUE("2024-02-29T13:45:07Z"_dt < "2024-02-29T13:45:08Z"_dt);
+    ASSERT_FALSE("2024-02-29T13:45:08Z"_dt < "2024-02-29T13:45:07Z"_dt);
+
+    ASSERT_EQ(Date{std::string{"2024-01-31"}} + std::chrono::months{1}, Date{std::string{"2024-02-29"}});
+    ASSERT_EQ(Date{std::string{"2024-02-29"}} - std::chrono::years{1}, Date{std::string{"2023-02-28"}});
+    ASSERT_EQ(Date{std::string{"2024-01-01"}} - std::chrono::days{1}, Date{std::string{"2023-12-31"}});
+}
+
+TEST(BusinessCalendar, Queries) {
+    const std::vector< Date > holidays{Date{std::string{"2024-01-01"}}, Date{std::string{"2024-12-25"}}, Date{std::string{"2025-01-01"}},
+                                       Date{std::string{"2025-05-03"}}, Date{std::string{"2026-12-25"}}};
+    for (const auto& weekend: {std::vector{std::chrono::Saturday, std::chrono::Sunday}, std::vector{std::chrono::Friday, std::chrono::Saturday}}) {
+        BusinessCalendar calendar{weekend};
+        calendar.addHolidays(holidays);
+        calendar.addHoliday(holidays.front());
+
+        const auto is_business_day = [&](const Date& p_date) -> bool {
+            return std::ranges::find(weekend, p_date.weekDay()) == weekend.end() && std::ranges::find(holidays, p_date) == holidays.end();
+        };
+        const Date first{std::string{"2023-10-01"}};
+        std::vector< Date > business_days;
+        for (Date date = first; date < Date{std::string{"2027-04-01"}}; date += std::chrono::days{1}) {
+            ASSERT_EQ(calendar.isBusinessDay(date), is_business_day(date)) << date;
+            ASSERT_EQ(calendar.businessDaysBetween(first, date), static_cast< int64_t >(business_days.size())) << date;
+            ASSERT_EQ(calendar.businessDaysBetween(date, first), -static_cast< int64_t >(business_days.size())) << date;
+            if (is_business_day(date)) {
+                business_days.push_back(date);
+            }
+        }
+        for (std::size_t i = 0; i < business_days.size(); i += 7) {
+            for (const std::size_t step: {std::size_t{1}, std::size_t{20}, std::size_t{250}}) {
+                if (i + step < business_days.size()) {
+                    ASSERT_EQ(calendar.addBusinessDays(business_days[i], static_cast< int64_t >(step)), business_days[i + step]) << business_days[i];
+                    ASSERT_EQ(calendar.addBusinessDays(business_days[i + step], -static_cast< int64_t >(step)), business_days[i]) << business_days[i];
+                }
+            }
+        }
+    }
+
+    const BusinessCalendar calendar;
+    const Date saturday{std::string{"2024-03-02"}};
+    ASSERT_EQ(calendar.addBusinessDays(saturday, 1), Date{std::string{"2024-03-04"}});
+    ASSERT_EQ(calendar.addBusinessDays(saturday, -1), Date{std::string{"2024-03-01"}});
+    ASSERT_EQ(calendar.addBusinessDays(saturday, 0), saturday);
+    ASSERT_EQ(calendar.businessDaysBetween(Date{std::string{"1900-01-01"}}, Date{std::string{"1900-01-08"}}), 5);
+    ASSERT_EQ(calendar.addBusinessDays(Date{std::string{"1900-01-01"}}, 5), Date{std::string{"1900-01-08"}});
+    const std::array< std::chrono::weekday, 7 > week{std::chrono::Monday, std::chrono::Tuesday, std::chrono::Wednesday, std::chrono::Thursday,
+                                                     std::chrono::Friday,  std::chrono::Saturday, std::chrono::Sunday};
+    ASSERT_THROW(BusinessCalendar{week}, std::invalid_argument);
+    ASSERT_THROW(BusinessCalendar{std::array{std::chrono::weekday{8}}}, std::invalid_argument);
+}
+
+TEST(Recurrence, Occurrences) {
+    static_assert(std::ranges::input_range< Recurrence > && std::ranges::view< Recurrence >);
+    const auto dates = [](const auto& p_range) -> std::vector< std::string > {
+        std::vector< std::string > result;
+        for (const auto& date_time: p_range) {
+            result.push_back(date_time.date().toString());
+        }
+        return result;
+    };
+
+    const Recurrence daily{"2024-02-27T09:30:00+03"_dt, RecurrenceRule{.frequency = Frequency::Daily, .interval = 2, .count = 4}};
+    ASSERT_EQ(dates(daily), (std::vector< std::string >{"2024-02-27", "2024-02-29", "2024-03-02", "2024-03-04"}));
+    ASSERT_EQ(*daily.begin(), "2024-02-27T09:30:00+03"_dt);
+
+    const Recurrence weekly{"2024-03-06T09:30:00Z"_dt,
+                            RecurrenceRule{.frequency = Frequency::Weekly,
+                                           .interval = 2,
+                                           .week_days = static_cast< uint8_t >(weekDayBit(std::chrono::Monday) | weekDayBit(std::chrono::Friday)),
+                                           .until = "2024-04-01T09:30:00Z"_dt}};
+    ASSERT_EQ(dates(weekly), (std::vector< std::string >{"2024-03-08", "2024-03-18", "2024-03-22", "2024-04-01"}));
+
+    const Recurrence end_of_month{"2024-01-31T00:00:00Z"_dt, RecurrenceRule{.frequency = Frequency::Monthly, .count = 4}};
+    ASSERT_EQ(dates(end_of_month), (std::vector< std::string >{"2024-01-31", "2024-02-29", "2024-03-31", "2024-04-30"}));
+
+    const Recurrence second_tuesday{"2024-01-20T00:00:00Z"_dt,
+                                    RecurrenceRule{.frequency = Frequency::Monthly, .week_days = weekDayBit(std::chrono::Tuesday), .ordinal = 2, .count = 3}};
+    ASSERT_EQ(dates(second_tuesday), (std::vector< std::string >{"2024-02-13", "2024-03-12", "2024-04-09"}));
+
+    const Recurrence last_friday{"2024-01-01T00:00:00Z"_dt,
+                                 RecurrenceRule{.frequency = Frequency::Monthly, .interval = 3, .week_days = weekDayBit(std::chrono::Friday), .ordinal = -1, .count = 3}};
+    ASSERT_EQ(dates(last_friday), (std::vector< std::string >{"2024-01-26", "2024-04-26", "2024-07-26"}));
+
+    const Recurrence fifth_thursday{"2024-01-01T00:00:00Z"_dt,
+                                    RecurrenceRule{.frequency = Frequency::Monthly, .week_days = weekDayBit(std::chrono::Thursday), .ordinal = 5, .count = 4}};
+    ASSERT_EQ(dates(fifth_thursday), (std::vector< std::string >{"2024-02-29", "2024-05-30", "2024-08-29", "2024-10-31"}));
+
+    const Recurrence leap_day{"2024-02-29T00:00:00Z"_dt, RecurrenceRule{.frequency = Frequency::Yearly, .until = "2028-02-29T00:00:00Z"_dt}};
+    ASSERT_EQ(dates(leap_day), (std::vector< std::string >{"2024-02-29", "2025-02-28", "2026-02-28", "2027-02-28", "2028-02-29"}));
+
+    for (const auto& recurrence: {daily, weekly, end_of_month, second_tuesday, last_friday, fifth_thursday, leap_day,
+                                  Recurrence{"2024-03-06T09:30:00+03"_dt, RecurrenceRule{.frequency = Frequency::Weekly, .week_days = 0x7f, .count = 500}},
+                                  Recurrence{"2024-03-06T09:30:00Z"_dt, RecurrenceRule{.frequency = Frequency::Monthly, .week_days = weekDayBit(std::chrono::Sunday),
+                                                                                           .ordinal = -5, .count = 60}}}) {
+        std::vector< DateTime > all;
+        for (const auto& date_time: recurrence) {
+            all.push_back(date_time);
+        }
+        const auto offset = all.front().time().offset();
+        for (Date date{std::string{"2023-12-01"}}; date < Date{std::string{"2030-01-01"}}; date += std::chrono::days{5}) {
+            const DateTime moment{date, Time{std::chrono::hours{9} + std::chrono::minutes{30}, offset}};
+            const auto next = std::ranges::find_if(all, [&moment](const DateTime& p_date_time) { return moment < p_date_time; });
+            auto after = recurrence.after(moment);
+            std::vector< DateTime > expected(next, std::min(next + 3, all.end()));
+            std::vector< DateTime > result;
+            for (auto iterator = after.begin(); iterator != after.end() && result.size() < 3; ++iterator) {
+                ASSERT_EQ(iterator.index(), static_cast< uint64_t >(next - all.begin()) + result.size());
+                result.push_back(*iterator);
+            }
+            ASSERT_EQ(result, expected) << moment;
+        }
+    }
+    // Occurrences of fifth day of the week rules before distant moments are counted without walking from the start.
+    for (const int8_t ordinal: {5, -5}) {
+        const Recurrence fifth{"2024-03-06T09:30:00Z"_dt, RecurrenceRule{.frequency = Frequency::Monthly, .interval = 7, .week_days = weekDayBit(std::chrono::Sunday),
+                                                                         .ordinal = ordinal, .count = 1'000'000}};
+        for (const auto& moment: {"2024-03-06T09:30:00Z"_dt, "2455-07-01T00:00:00Z"_dt, "3210-12-31T23:59:59Z"_dt, "6100-01-01T00:00:00Z"_dt}) {
+            uint64_t preceding{0};
+            for (auto iterator = fifth.begin(); iterator != fifth.end() && not(moment < *iterator); ++iterator) {
+                ++preceding;
+            }
+            const auto after = fifth.after(moment).begin();
+            ASSERT_EQ(after.index(), preceding) << moment;
+            ASSERT_LT(moment, *after);
+        }
+    }
+    ASSERT_EQ(dates(daily.after("2024-02-29T08:00:00+01"_dt)), (std::vector< std::string >{"2024-03-02", "2024-03-04"}));
+    ASSERT_EQ(dates(daily.after("2024-02-29T05:00:00-01"_dt)), (std::vector< std::string >{"2024-02-29", "2024-03-02", "2024-03-04"}));
+
+    // Occurrences of start in IANA time zone follow its daylight saving transitions.
+    const auto new_york = ZoneDatabase::locate("America/New_York");
+    const Recurrence zoned{DateTime{"2024-01-15"_date, "09:00:00"_time, new_york}, RecurrenceRule{.frequency = Frequency::Monthly, .count = 8}};
+    const auto strings = [](auto&& p_range) -> std::vector< std::string > {
+        std::vector< std::string > result;
+        for (const auto& date_time: p_range) {
+            result.push_back(date_time.toString());
+        }
+        return result;
+    };
+    ASSERT_EQ(strings(zoned | std::views::drop(1) | std::views::take(3)),
+              (std::vector< std::string >{"2024-02-15T09:00:00.000000000-05:00", "2024-03-15T09:00:00.000000000-04:00", "2024-04-15T09:00:00.000000000-04:00"}));
+    ASSERT_EQ((*std::ranges::next(zoned.begin(), 6)).toString(), "2024-07-15T09:00:00.000000000-04:00");
+    ASSERT_EQ((*std::ranges::next(zoned.begin(), 6)).time().zone(), new_york);
+    ASSERT_EQ(dates(zoned.after("2024-07-15T12:30:00Z"_dt)), (std::vector< std::string >{"2024-07-15", "2024-08-15"}));
+    ASSERT_EQ(dates(zoned.after("2024-07-15T13:30:00Z"_dt)), (std::vector< std::string >{"2024-08-15"}));
+    ASSERT_EQ(zoned.after("2024-07-15T13:30:00Z"_dt).begin().index(), 7U);
+    const Recurrence across_gap{DateTime{"2024-03-08"_date, "02:30:00"_time, new_york},
+                                RecurrenceRule{.frequency = Frequency::Daily, .until = "2024-03-11T06:30:00Z"_dt}};
+    ASSERT_EQ(strings(across_gap),
+              (std::vector< std::string >{"2024-03-08T02:30:00.000000000-05:00", "2024-03-09T02:30:00.000000000-05:00", "2024-03-10T03:30:00.000000000-04:00",
+                                          "2024-03-11T02:30:00.000000000-04:00"}));
+    ASSERT_EQ(dates(across_gap.after("2024-03-10T07:00:00Z"_dt)), (std::vector< std::string >{"2024-03-10", "2024-03-11"}));
+    ASSERT_EQ(zoned.after("6100-01-01T00:00:00Z"_dt).begin(), zoned.end());
+
+    ASSERT_THROW((Recurrence{"2024-01-01T00:00:00Z"_dt, RecurrenceRule{.interval = 0}}), std::invalid_argument);
+    ASSERT_THROW((Recurrence{"2024-01-01T00:00:00Z"_dt, RecurrenceRule{.frequency = Frequency::Monthly, .week_days = 0x3, .ordinal = 1}}), std::invalid_argument);
+    ASSERT_THROW((Recurrence{"2024-01-01T00:00:00Z"_dt, RecurrenceRule{.frequency = Frequency::Weekly, .week_days = 0x1, .ordinal = 1}}), std::invalid_argument);
+}
+
+TEST(DateRange, Elements) {
+    static_assert(std::ranges::random_access_range< DateRange > && std::ranges::sized_range< DateRange > && std::ranges::view< DateRange >);
+    static_assert(std::ranges::random_access_range< DateTimeRange > && std::ranges::sized_range< DateTimeRange > && std::ranges::view< DateTimeRange >);
+
+    const Date first{std::string{"1990-01-31"}};
+    for (const auto& [step, months, days]: {std::tuple{DateDuration{std::chrono::days{1}}, 0, 1}, std::tuple{DateDuration{std::chrono::days{7}}, 0, 7},
+                                            std::tuple{DateDuration{std::chrono::days{-3}}, 0, -3}, std::tuple{DateDuration{std::chrono::months{1}}, 1, 0},
+                                            std::tuple{DateDuration{std::chrono::months{-5}}, -5, 0}, std::tuple{DateDuration{std::chrono::years{2}}, 24, 0}}) {
+        for (const Date& last: {Date{std::string{"2030-02-28"}}, Date{std::string{"1950-03-30"}}, Date{std::string{"1990-01-30"}}, first}) {
+            std::vector< Date > expected;
+            for (int32_t i = 0;; ++i) {
+                const auto month = std::chrono::year_month{first.year(), first.month()} + std::chrono::months{i * months};
+                const auto day = std::min(first.monthDay(), std::chrono::year_month_day_last{month.year(), std::chrono::month_day_last{month.month()}}.day());
+                const auto date = Date{std::chrono::sys_days{month.year() / month.month() / day} + std::chrono::days{i * days}};
+                if (months + days > 0 ? last < date : date < last) {
+                    break;
+                }
+                expected.push_back(date);
+            }
+            const DateRange range{first, last, step};
+            ASSERT_EQ(range.size(), expected.size()) << last;
+            ASSERT_TRUE(std::ranges::equal(range, expected));
+            ASSERT_TRUE(std::ranges::equal(range | std::views::reverse, expected | std::views::reverse));
+            for (std::size_t i = 0; i < expected.size(); i += 97) {
+                ASSERT_EQ(range[static_cast< std::ptrdiff_t >(i)], expected[i]);
+                ASSERT_EQ(range.begin()[static_cast< std::ptrdiff_t >(i)], expected[i]);
+            }
+            ASSERT_THROW((void)range.at(expected.size()), std::out_of_range);
+        }
+    }
+    const DateRange days{Date{std::string{"2024-02-26"}}, Date{std::string{"2024-03-10"}}};
+    auto weekends = days | std::views::filter([](const Date& p_date) { return p_date.isWeekend(); }) | std::views::transform([](const Date& p_date) {
+                              return p_date.toString();
+                          });
+    ASSERT_EQ(std::vector(weekends.begin(), weekends.end()), (std::vector< std::string >{"2024-03-02", "2024-03-03", "2024-03-09", "2024-03-10"}));
+    ASSERT_THROW((DateRange{first, first, std::chrono::days{0}}), std::invalid_argument);
+
+    // Iterators do not refer to the range, so they outlive temporary ones.
+    static_assert(std::ranges::borrowed_range< DateRange > && std::ranges::borrowed_range< DateTimeRange >);
+    static_assert(std::ranges::random_access_range< DateRange > && std::ranges::sized_range< DateTimeRange >);
+    std::vector< Date > taken;
+    for (const auto date: DateRange{first, Date{std::string{"2030-01-01"}}, std::chrono::months{1}} | std::views::take(3)) {
+        taken.push_back(date);
+    }
+    ASSERT_EQ(taken, (std::vector< Date >{first, first + std::chrono::months{1}, first + std::chrono::months{2}}));
+    const auto found = std::ranges::find(DateRange{first, Date{std::string{"2030-01-01"}}}, first + std::chrono::days{40});
+    static_assert(not std::is_same_v< decltype(found), const std::ranges::dangling >);
+    ASSERT_EQ(*found, first + std::chrono::days{40});
+    ASSERT_EQ(found[1], first + std::chrono::days{41});
+    const auto minute = std::ranges::begin(DateTimeRange{"2024-02-29T00:00:00+03"_dt, "2024-03-01T00:00:00+03"_dt, std::chrono::minutes{1}}) + 90;
+    ASSERT_EQ(*minute, "2024-02-29T01:30:00+03"_dt);
+
+    const DateTimeRange hours{"2024-02-28T22:30:00+03"_dt, "2024-02-29T01:00:00Z"_dt, std::chrono::hours{1}};
+    ASSERT_EQ(hours.size(), 6);
+    ASSERT_EQ(hours.front(), "2024-02-28T22:30:00+03"_dt);
+    ASSERT_EQ(hours[2], "2024-02-29T00:30:00+03"_dt);
+    ASSERT_EQ(hours.back(), "2024-02-29T03:30:00+03"_dt);
+    ASSERT_EQ(hours.end() - hours.begin(), 6);
+    const DateTimeRange backwards{"2024-02-29T00:00:00Z"_dt, "2024-02-28T23:59:59.999Z"_dt, std::chrono::microseconds{-1}};
+    ASSERT_EQ(backwards.size(), 1'001);
+    ASSERT_EQ(backwards.back(), "2024-02-28T23:59:59.999Z"_dt);
+    ASSERT_EQ((DateTimeRange{"2024-02-29T00:00:00Z"_dt, "2024-02-28T00:00:00Z"_dt, std::chrono::seconds{1}}.size()), 0);
+    ASSERT_EQ((DateTimeRange{"1677-09-22T00:00:00Z"_dt, "2262-04-10T00:00:00Z"_dt, std::chrono::hours{24}}.size()), 213'502);
+}
+
+TEST(ZoneDatabase, Offsets) {
+    const auto* const time_zone = std::getenv("TZ");
+    const std::string previous = time_zone == nullptr ? "" : time_zone;
+    for (const auto* name: {"America/New_York", "Asia/Kolkata", "Australia/Sydney", "Europe/London", "America/St_Johns"}) {
+        const auto& zone = ZoneDatabase::zone(ZoneDatabase::locate(name));
+        ASSERT_EQ(zone.name(), name);
+        setenv("TZ", name, 1);
+        tzset();
+        // From 1901 to 2100 with the step which does not divide day, so every time of the day is visited.
+        for (int64_t seconds = -2'177'452'800; seconds < 4'102'444'800; seconds += 86'400 * 3 + 3'607) {
+            const auto time = static_cast< time_t >(seconds);
+            std::tm local{};
+            localtime_r(&time, &local);
+            ASSERT_EQ(zone.offset(std::chrono::sys_seconds{std::chrono::seconds{seconds}}).count(), local.tm_gmtoff) << name << ' ' << seconds;
+        }
+    }
+    if (time_zone == nullptr) {
+        unsetenv("TZ");
+    } else {
+        setenv("TZ", previous.c_str(), 1);
+    }
+    tzset();
+
+    const auto new_york = ZoneDatabase::locate("America/New_York");
+    ASSERT_EQ(ZoneDatabase::locate("America/New_York"), new_york);
+    ASSERT_EQ((DateTime{"2024-03-10"_date, "02:30:00"_time, new_york}.toString()), "2024-03-10T03:30:00.000000000-04:00");
+    ASSERT_EQ((DateTime{"2024-11-03"_date, "01:30:00"_time, new_york}.toString()), "2024-11-03T01:30:00.000000000-04:00");
+    ASSERT_EQ((DateTime{"2024-11-03"_date, "01:30:00"_time, new_york, Choose::Latest}.toString()), "2024-11-03T01:30:00.000000000-05:00");
+    ASSERT_EQ((DateTime{"2024-11-03"_date, "01:30:00"_time, new_york, Choose::Latest}.sinceEpoch()), "2024-11-03T06:30:00Z"_dt.sinceEpoch());
+
+    const auto kolkata = ZoneDatabase::locate("Asia/Kolkata");
+    const DateTime date_time{"2024-06-01T00:00:00Z"_dt.sinceEpoch(), kolkata};
+    ASSERT_EQ(date_time.toString(), "2024-06-01T05:30:00.000000000+05:30");
+    ASSERT_EQ(date_time.time().zone(), kolkata);
+    ASSERT_EQ(date_time.time().utcOffset(), std::chrono::minutes{330});
+    ASSERT_EQ(date_time.time().offset(), TimeZone::EAST_5);
+    ASSERT_EQ(date_time.sinceEpoch(), "2024-06-01T00:00:00Z"_dt.sinceEpoch());
+    ASSERT_EQ((DateTime{"2090-01-01T00:00:00Z"_dt.sinceEpoch(), ZoneDatabase::locate("Australia/Sydney")}.time().utcOffset()), std::chrono::hours{11});
+
+    // Arithmetic across transitions resolves the offset again.
+    const DateTime before_gap{"2024-03-10"_date, "01:30:00"_time, new_york};
+    ASSERT_EQ((before_gap + std::chrono::hours{1}).toString(), "2024-03-10T03:30:00.000000000-04:00");
+    ASSERT_EQ((before_gap + std::chrono::hours{1}).sinceEpoch(), before_gap.sinceEpoch() + std::chrono::hours{1});
+    ASSERT_EQ((before_gap + std::chrono::hours{1} - std::chrono::minutes{60}).toString(), before_gap.toString());
+    const DateTime before_overlap{"2024-11-03"_date, "01:30:00"_time, new_york};
+    ASSERT_EQ((before_overlap + std::chrono::hours{1}).toString(), "2024-11-03T01:30:00.000000000-05:00");
+    ASSERT_EQ((before_overlap + std::chrono::days{1}).toString(), "2024-11-04T01:30:00.000000000-05:00");
+    ASSERT_EQ((before_gap + DateDuration{std::chrono::months{4}}).toString(), "2024-07-10T01:30:00.000000000-04:00");
+    ASSERT_EQ((before_gap - DateDuration{std::chrono::days{1}}).time().utcOffset(), std::chrono::hours{-5});
+    ASSERT_EQ((before_gap + DateDuration{std::chrono::months{4}}).time().zone(), new_york);
+    const DateTime before_midnight{"2024-06-10"_date, "23:30:00"_time, new_york};
+    ASSERT_EQ((before_midnight + std::chrono::hours{1}).toString(), "2024-06-11T00:30:00.000000000-04:00");
+    ASSERT_EQ((before_midnight + std::chrono::hours{1}).sinceEpoch(), before_midnight.sinceEpoch() + std::chrono::hours{1});
+    const DateTime after_midnight{"2024-06-11"_date, "00:30:00"_time, new_york};
+    ASSERT_EQ((after_midnight - std::chrono::minutes{60}).toString(), "2024-06-10T23:30:00.000000000-04:00");
+    ASSERT_EQ((after_midnight - std::chrono::minutes{60}).sinceEpoch(), after_midnight.sinceEpoch() - std::chrono::hours{1});
+    ASSERT_EQ((before_midnight + std::chrono::hours{49}).toString(), "2024-06-13T00:30:00.000000000-04:00");
+
+    // Offsets beyond TimeZone range are kept exactly by utcOffset() and clamped by offset().
+    const auto kiritimati = ZoneDatabase::locate("Pacific/Kiritimati");
+    const DateTime line_islands{"2024-06-01T00:00:00Z"_dt.sinceEpoch(), kiritimati};
+    ASSERT_EQ(line_islands.toString(), "2024-06-01T14:00:00.000000000+14:00");
+    ASSERT_EQ(line_islands.time().utcOffset(), std::chrono::hours{14});
+    ASSERT_EQ(line_islands.time().offset(), TimeZone::EAST_12);
+    ASSERT_EQ(line_islands.sinceEpoch(), "2024-06-01T00:00:00Z"_dt.sinceEpoch());
+    static_assert(toTimeZone(std::chrono::hours{-13}) == TimeZone::WEST_12);
+    static_assert(toTimeZone(std::chrono::minutes{-210}) == TimeZone::WEST_3);
+
+    ASSERT_THROW(static_cast< void >(ZoneDatabase::locate("Mars/Olympus_Mons")), std::invalid_argument);
+    ASSERT_THROW(static_cast< void >(ZoneDatabase::locate("../zoneinfo/UTC")), std::invalid_argument);
+    ASSERT_THROW(static_cast< void >(ZoneDatabase::locate("")), std::invalid_argument);
+    ASSERT_THROW(static_cast< void >(ZoneDatabase::zone(static_cast< ZoneId >(ZoneDatabase::max_zones))), std::out_of_range);
+}
+
+TEST(ZoneConversion, Bulk) {
+    const auto sydney = ZoneDatabase::locate("Australia/Sydney");
+    std::vector< int64_t > instants;
+    // Sorted instants from 2019 to 2025 followed by shuffled ones, every 37 minutes and 11 seconds.
+    for (int64_t seconds = 1'546'300'800; instants.size() < (1 << 16); seconds += 2'231) {
+        instants.push_back(seconds * 1'000'000'000 + seconds % 1'000);
+    }
+    std::mt19937_64 generator{7};
+    std::shuffle(instants.begin() + (1 << 15), instants.end(), generator);
+    instants.push_back(std::numeric_limits< int64_t >::min());
+    instants.push_back(std::numeric_limits< int64_t >::max());
+
+    std::vector< DateTime > local(instants.size());
+    std::vector< int64_t > utc(instants.size());
+    batch::Executor executor{4};
+    for (const bool parallel: {false, true}) {
+        if (parallel) {
+            batch::toLocal(executor, instants, sydney, local);
+            batch::toUtc(executor, local, sydney, utc);
+        } else {
+            batch::toLocal(instants, sydney, local);
+            batch::toUtc(local, sydney, utc);
+        }
+        for (std::size_t i = 0; i < instants.size(); ++i) {
+            const DateTime expected{std::chrono::nanoseconds{instants[i]}, sydney};
+            ASSERT_EQ(local[i].toString(), expected.toString()) << i;
+            ASSERT_EQ(local[i].time().zone(), sydney);
+            if (i < instants.size() - 2) {
+                ASSERT_EQ(utc[i], (DateTime{local[i].date(), local[i].time(), sydney}.sinceEpoch().count())) << i;
+            }
+        }
+    }
+    batch::toUtc(executor, local, sydney, utc, Choose::Latest);
+    for (std::size_t i = 0; i < instants.size() - 2; ++i) {
+        ASSERT_EQ(utc[i], (DateTime{local[i].date(), local[i].time(), sydney, Choose::Latest}.sinceEpoch().count())) << i;
+    }
+
+    ASSERT_THROW(batch::toLocal(instants, sydney, std::span{local}.first(1)), std::invalid_argument);
+    ASSERT_THROW(batch::toUtc(local, sydney, std::span{utc}.first(1)), std::invalid_argument);
+    ASSERT_THROW(batch::toLocal(instants, ZoneId::None, local), std::out_of_range);
+}
+
+TEST(Executor, Chunks) {
+    batch::Executor executor{4};
+    ASSERT_EQ(executor.threads(), 4);
+    std::vector< int > visits(100'003);
+    executor.forEachChunk(
+        visits.size(),
+        [&visits](const std::size_t p_first, const std::size_t p_last) {
+            for (auto i = p_first; i < p_last; ++i) {
+                ++visits[i];
+            }
+        },
+        1'000);
+    ASSERT_TRUE(std::ranges::all_of(visits, [](const int p_visits) { return p_visits == 1; }));
+
+    std::atomic< std::size_t > nested{0};
+    executor.forEachChunk(64, [&](std::size_t, std::size_t) { executor.forEachChunk(64, [&](const std::size_t p_first, const std::size_t p_last) { nested += p_last - p_first; }, 8); }, 8);
+    ASSERT_EQ(nested, 8 * 64);
+    ASSERT_THROW(executor.forEachChunk(
+                     100,
+                     [](const std::size_t p_first, std::size_t) {
+                         if (p_first == 50) {
+                             throw std::range_error("chunk");
+                         }
+                     },
+                     10),
+                 std::range_error);
+
+    std::vector< DateTime > date_times;
+    std::vector< std::string > strings;
+    const auto twoDigits = [](const int p_value) { return std::string(p_value < 10 ? "0" : "") + std::to_string(p_value); };
+    for (int i = 0; i < 20'000; ++i) {
+        date_times.emplace_back(std::chrono::nanoseconds{i * 7'777'777'777'777 - 1'000'000'000'000'000'000}, static_cast< TimeZone >(i % 25 - 12));
+        const auto offset = i % 25 - 12;
+        strings.push_back(i % 1'000 == 0 ? "invalid"
+                                         : std::to_string(1900 + i % 200) + "-" + twoDigits(1 + i % 12) + "-" + twoDigits(1 + i % 28) + "T" + twoDigits(i % 24) + ":"
+                                               + twoDigits(i % 60) + ":" + twoDigits(i / 7 % 60) + "." + std::to_string(100 + i % 900) + (offset < 0 ? "-" : "+")
+                                               + twoDigits(offset < 0 ? -offset : offset));
+    }
+    const std::vector< std::string_view > views(strings.begin(), strings.end());
+    std::vector< char > buffer(batch::formattedDateTimesLength(date_times.size()));
+    std::vector< char > parallel_buffer(buffer.size());
+    std::vector< int64_t > offsets(date_times.size() + 1);
+    std::vector< int64_t > parallel_offsets(offsets.size());
+    const auto length = batch::formatDateTimes(date_times, buffer, offsets);
+    ASSERT_EQ(batch::formatDateTimes(executor, date_times, parallel_buffer, parallel_offsets), length);
+    ASSERT_EQ(offsets, parallel_offsets);
+    ASSERT_TRUE(std::equal(buffer.begin(), buffer.begin() + static_cast< std::ptrdiff_t >(length), parallel_buffer.begin()));
+
+    std::vector< std::chrono::year_month_day > dates(views.size());
+    std::vector< std::chrono::nanoseconds > times(views.size());
+    std::vector< TimeZone > zones(views.size());
+    std::vector< uint64_t > validity(batch::validityWords(views.size()));
+    auto serial_dates = dates;
+    auto serial_times = times;
+    auto serial_zones = zones;
+    auto serial_validity = validity;
+    ASSERT_EQ(batch::parseDateTimes(views, {serial_dates, serial_times, serial_zones, serial_validity}), views.size() - 20);
+    ASSERT_EQ(batch::parseDateTimes(executor, views, {dates, times, zones, validity}), views.size() - 20);
+    ASSERT_EQ(dates, serial_dates);
+    ASSERT_EQ(times, serial_times);
+    ASSERT_EQ(zones, serial_zones);
+    ASSERT_EQ(validity, serial_validity);
+    ASSERT_THROW(static_cast< void >(batch::parseDateTimes(executor, views, {dates, std::span{times}.first(1), zones, validity})), std::invalid_argument);
+}
+
+TEST(Instrumentation, Counters) {
+    instrumentation::reset();
+    EXPECT_THROW(Date{std::string{"2024-13-01"}}, std::range_error);
+    EXPECT_THROW(Time{std::string{"2a:00"}}, std::invalid_argument);
+    ASSERT_FALSE(Date::tryParse("2024-02-30").has_value());
+    ASSERT_EQ(Date{std::string{"2024-02-29"}}.toString(), "2024-02-29");
+    std::thread{[] { [[maybe_unused]] const Time now; }}.join();
+
+    const auto snapshot = instrumentation::snapshot();
+    const uint64_t expected = instrumentation::enabled ? 1 : 0;
+    ASSERT_EQ(snapshot.counter(instrumentation::Counter::DateParses), 3 * expected);
+    ASSERT_EQ(snapshot.counter(instrumentation::Counter::TimeParses), expected);
+    ASSERT_EQ(snapshot.counter(instrumentation::Counter::DateRangeError), expected);
+    ASSERT_EQ(snapshot.counter(instrumentation::Counter::TimeInvalidArgument), expected);
+    ASSERT_EQ(snapshot.counter(instrumentation::Counter::StringAllocations), expected);
+    // Counters of exited threads are kept.
+    ASSERT_EQ(snapshot.counter(instrumentation::Counter::ClockReads), expected);
+    ASSERT_EQ(snapshot.parseFailures(parser::ErrorCode::InvalidMonth), expected);
+    ASSERT_EQ(snapshot.parseFailures(parser::ErrorCode::InvalidCharacter), expected);
+    ASSERT_EQ(snapshot.parseFailures(parser::ErrorCode::InvalidDay), expected);
+    ASSERT_EQ(instrumentation::name(instrumentation::Counter::LocaltimeCalls), "localtime_calls");
+
+    instrumentation::enableHistograms(true);
+    ASSERT_TRUE(DateTime::tryParse("2024-02-29T13:45:00.250+03").has_value());
+    instrumentation::enableHistograms(false);
+    const auto histogram = instrumentation::snapshot().histogram(instrumentation::Histogram::DateTimeParse);
+    ASSERT_EQ(std::accumulate(histogram.begin(), histogram.end(), uint64_t{0}), expected);
+
+    instrumentation::reset();
+    ASSERT_EQ(instrumentation::snapshot().counter(instrumentation::Counter::DateParses), 0);
+}
+
+TEST(TimestampStream, RoundTrip) {
+    std::mt19937_64 engine{7};
+    std::uniform_int_distribution< int64_t > jitter{-2'000, 2'000};
+    std::uniform_int_distribution< int > kind{0, 99};
+    std::vector< int64_t > values;
+    int64_t value{1'709'249'400'000'000'000};
+    for (std::size_t i = 0; i < 5'000; ++i) {
+        // Mostly regular millisecond ticks with jitter, gaps and values at the ends of the range.
+        const auto roll = kind(engine);
+        if (roll == 0) {
+            values.push_back(std::numeric_limits< int64_t >::min());
+        } else if (roll == 1) {
+            values.push_back(std::numeric_limits< int64_t >::max());
+        } else {
+            value += roll < 10 ? static_cast< int64_t >(engine() % 3'600'000'000'000) : 1'000'000 + (roll < 40 ? jitter(engine) : 0);
+            values.push_back(value);
+        }
+    }
+    const batch::TimestampStream stream{values};
+    ASSERT_EQ(stream.size(), values.size());
+    std::vector< int64_t > decoded(values.size());
+    stream.decode(0, decoded);
+    ASSERT_EQ(decoded, values);
+    std::vector< int64_t > window(1'500);
+    stream.decode(1'000, window);
+    ASSERT_TRUE(std::equal(window.begin(), window.end(), values.begin() + 1'000));
+    for (const std::size_t row: {std::size_t{0}, std::size_t{1}, std::size_t{1'023}, std::size_t{1'024}, std::size_t{4'999}}) {
+        ASSERT_EQ(stream.at(row), values[row]);
+    }
+    ASSERT_THROW(static_cast< void >(stream.at(values.size())), std::out_of_range);
+    ASSERT_THROW(stream.decode(4'000, window), std::out_of_range);
+
+    batch::TimestampStream regular;
+    for (int64_t i = 0; i < 100'000; ++i) {
+        regular.append(DateTime{std::chrono::nanoseconds{1'709'249'400'000'000'000 + i * 1'000'000}, TimeZone::EAST_2});
+    }
+    ASSERT_LT(regular.bytes() * 50, regular.size() * sizeof(DateTime));
+    std::vector< DateTime > date_times(3);
+    regular.decode(99'997, date_times, TimeZone::EAST_2);
+    ASSERT_EQ(date_times.back(), (DateTime{std::chrono::nanoseconds{1'709'249'400'000'000'000 + int64_t{99'999} * 1'000'000}, TimeZone::EAST_2}));
+    ASSERT_EQ(date_times.back().time().offset(), TimeZone::EAST_2);
+}
+
 #endif  // TESTS_HPP
\ No newline at end of file
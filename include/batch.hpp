@@ -0,0 +1,202 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include "date_time.hpp"
+#include "executor.hpp"
+#include "parser.hpp"
+#include "time_zones.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+/**
+ * \brief Namespace which includes bulk, column oriented, counterparts of Date, Time and DateTime operations
+ */
+namespace mt::batch {
+
+    /**
+     * \brief Returns number of 64 bit words validity bitmap of p_rows rows occupies.
+     * \param p_rows std::size_t
+     * \return std::size_t
+     */
+    constexpr auto validityWords(const std::size_t p_rows) noexcept -> std::size_t { return (p_rows + 63) / 64; }
+
+    /**
+     * \brief Checks validity bit of the row.
+     * \note Bits are stored least significant bit first, which matches Apache Arrow validity bitmaps on little endian platforms.
+     * \param p_validity std::span< const uint64_t >
+     * \param p_row std::size_t
+     * \return bool
+     */
+    constexpr auto isValid(const std::span< const uint64_t > p_validity, const std::size_t p_row) noexcept -> bool { return (p_validity[p_row / 64] >> (p_row % 64)) & 1U; }
+
+    /**
+     * \brief Output columns of parseDateTimes.
+     * \note Each column should have the size of the input, validity should hold at least validityWords(size) words.
+     * Invalid rows have zero initialized values and cleared validity bit.
+     */
+    struct DateTimeColumns {
+        std::span< std::chrono::year_month_day > dates;
+        std::span< std::chrono::nanoseconds > times;
+        std::span< TimeZone > offsets;
+        std::span< uint64_t > validity;
+    };
+
+    /**
+     * \brief Output columns of parseTimes.
+     * \note Each column should have the size of the input, validity should hold at least validityWords(size) words.
+     * Invalid rows have zero initialized values and cleared validity bit.
+     */
+    struct TimeColumns {
+        std::span< std::chrono::nanoseconds > times;
+        std::span< TimeZone > offsets;
+        std::span< uint64_t > validity;
+    };
+
+    /**
+     * \brief Output columns of parseDates.
+     * \note Dates column should have the size of the input, validity should hold at least validityWords(size) words.
+     * Invalid rows have zero initialized values and cleared validity bit.
+     */
+    struct DateColumns {
+        std::span< std::chrono::year_month_day > dates;
+        std::span< uint64_t > validity;
+    };
+
+    /**
+     * \brief Parses dates with the rules of Date::tryParse.
+     * \param p_input std::span< const std::string_view >
+     * \param p_output const DateColumns&
+     * \return Number of valid rows.
+     * \throws std::invalid_argument - if sizes of output columns do not match the input.
+     */
+    auto parseDates(std::span< const std::string_view > p_input, const DateColumns& p_output) -> std::size_t;
+    /**
+     * \overload
+     * \brief Parses rows in chunks run by p_executor. Output is the same as the single threaded overload produces.
+     * \param p_executor Executor&
+     */
+    auto parseDates(Executor& p_executor, std::span< const std::string_view > p_input, const DateColumns& p_output) -> std::size_t;
+    /**
+     * \overload
+     * \brief Parses dates stored in one buffer. Row i occupies [p_offsets[i], p_offsets[i + 1]) range of p_buffer.
+     * \param p_buffer std::string_view
+     * \param p_offsets std::span< const int64_t > number of rows plus one offsets.
+     * \param p_output const DateColumns&
+     * \return Number of valid rows.
+     * \throws std::invalid_argument - if sizes of output columns do not match the input or offsets exceed the buffer.
+     */
+    auto parseDates(std::string_view p_buffer, std::span< const int64_t > p_offsets, const DateColumns& p_output) -> std::size_t;
+    /**
+     * \overload
+     * \brief Parses rows in chunks run by p_executor. Output is the same as the single threaded overload produces.
+     * \param p_executor Executor&
+     */
+    auto parseDates(Executor& p_executor, std::string_view p_buffer, std::span< const int64_t > p_offsets, const DateColumns& p_output) -> std::size_t;
+    /**
+     * \brief Parses times with the rules of Time::tryParse.
+     * \param p_input std::span< const std::string_view >
+     * \param p_output const TimeColumns&
+     * \return Number of valid rows.
+     * \throws std::invalid_argument - if sizes of output columns do not match the input.
+     */
+    auto parseTimes(std::span< const std::string_view > p_input, const TimeColumns& p_output) -> std::size_t;
+    /**
+     * \overload
+     * \brief Parses rows in chunks run by p_executor. Output is the same as the single threaded overload produces.
+     * \param p_executor Executor&
+     */
+    auto parseTimes(Executor& p_executor, std::span< const std::string_view > p_input, const TimeColumns& p_output) -> std::size_t;
+    /**
+     * \overload
+     * \brief Parses times stored in one buffer. Row i occupies [p_offsets[i], p_offsets[i + 1]) range of p_buffer.
+     * \param p_buffer std::string_view
+     * \param p_offsets std::span< const int64_t > number of rows plus one offsets.
+     * \param p_output const TimeColumns&
+     * \return Number of valid rows.
+     * \throws std::invalid_argument - if sizes of output columns do not match the input or offsets exceed the buffer.
+     */
+    auto parseTimes(std::string_view p_buffer, std::span< const int64_t > p_offsets, const TimeColumns& p_output) -> std::size_t;
+    /**
+     * \overload
+     * \brief Parses rows in chunks run by p_executor. Output is the same as the single threaded overload produces.
+     * \param p_executor Executor&
+     */
+    auto parseTimes(Executor& p_executor, std::string_view p_buffer, std::span< const int64_t > p_offsets, const TimeColumns& p_output) -> std::size_t;
+    /**
+     * \brief Parses date times with the rules of DateTime::tryParse.
+     * \param p_input std::span< const std::string_view >
+     * \param p_output const DateTimeColumns&
+     * \return Number of valid rows.
+     * \throws std::invalid_argument - if sizes of output columns do not match the input.
+     */
+    auto parseDateTimes(std::span< const std::string_view > p_input, const DateTimeColumns& p_output) -> std::size_t;
+    /**
+     * \overload
+     * \brief Parses rows in chunks run by p_executor. Output is the same as the single threaded overload produces.
+     * \param p_executor Executor&
+     */
+    auto parseDateTimes(Executor& p_executor, std::span< const std::string_view > p_input, const DateTimeColumns& p_output) -> std::size_t;
+    /**
+     * \overload
+     * \brief Parses date times stored in one buffer. Row i occupies [p_offsets[i], p_offsets[i + 1]) range of p_buffer.
+     * \param p_buffer std::string_view
+     * \param p_offsets std::span< const int64_t > number of rows plus one offsets.
+     * \param p_output const DateTimeColumns&
+     * \return Number of valid rows.
+     * \throws std::invalid_argument - if sizes of output columns do not match the input or offsets exceed the buffer.
+     */
+    auto parseDateTimes(std::string_view p_buffer, std::span< const int64_t > p_offsets, const DateTimeColumns& p_output) -> std::size_t;
+    /**
+     * \overload
+     * \brief Parses rows in chunks run by p_executor. Output is the same as the single threaded overload produces.
+     * \param p_executor Executor&
+     */
+    auto parseDateTimes(Executor& p_executor, std::string_view p_buffer, std::span< const int64_t > p_offsets, const DateTimeColumns& p_output) -> std::size_t;
+
+    /**
+     * \brief Returns size of the buffer formatDateTimes needs for p_rows rows.
+     * \param p_rows std::size_t
+     * \return std::size_t
+     */
+    constexpr auto formattedDateTimesLength(const std::size_t p_rows) noexcept -> std::size_t { return p_rows * date_time::DateTime::max_string_length; }
+
+    /**
+     * \brief Formats date times into ISO standard representation, same as DateTime::toString produces, stored in one buffer.
+     * Row i occupies [p_offsets[i], p_offsets[i + 1]) range of p_buffer, which matches Apache Arrow string column layout.
+     * \note Fixed width fields are converted to digits with vector instructions if CPU supports them.
+     * \param p_input std::span< const date_time::DateTime >
+     * \param p_buffer std::span< char > should hold at least formattedDateTimesLength(size) characters.
+     * \param p_offsets std::span< int64_t > should hold size plus one offsets.
+     * \return Number of characters written.
+     * \throws std::invalid_argument - if buffer or offsets are too small.
+     */
+    auto formatDateTimes(std::span< const date_time::DateTime > p_input, std::span< char > p_buffer, std::span< int64_t > p_offsets) -> std::size_t;
+    /**
+     * \overload
+     * \brief Formats rows in chunks run by p_executor. Chunks are formatted in place and then moved together, so output is the same as the single threaded overload produces.
+     * \param p_executor Executor&
+     */
+    auto formatDateTimes(Executor& p_executor, std::span< const date_time::DateTime > p_input, std::span< char > p_buffer, std::span< int64_t > p_offsets) -> std::size_t;
+    /**
+     * \overload
+     * \brief Formats UTC date times given as nanoseconds since Unix epoch.
+     * \param p_epoch_nanoseconds std::span< const int64_t >
+     * \param p_buffer std::span< char > should hold at least formattedDateTimesLength(size) characters.
+     * \param p_offsets std::span< int64_t > should hold size plus one offsets.
+     * \return Number of characters written.
+     * \throws std::invalid_argument - if buffer or offsets are too small.
+     */
+    auto formatDateTimes(std::span< const int64_t > p_epoch_nanoseconds, std::span< char > p_buffer, std::span< int64_t > p_offsets) -> std::size_t;
+    /**
+     * \overload
+     * \brief Formats rows in chunks run by p_executor. Chunks are formatted in place and then moved together, so output is the same as the single threaded overload produces.
+     * \param p_executor Executor&
+     */
+    auto formatDateTimes(Executor& p_executor, std::span< const int64_t > p_epoch_nanoseconds, std::span< char > p_buffer, std::span< int64_t > p_offsets) -> std::size_t;
+
+}  // namespace mt::batch
+
+#endif  //BATCH_HPP
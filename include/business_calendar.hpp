@@ -0,0 +1,102 @@
+#ifndef BUSINESS_CALENDAR_HPP
+#define BUSINESS_CALENDAR_HPP
+
+#include "date.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace mt::date {
+
+    /**
+     * \brief Calendar of business days built from weekend days and list of holidays.
+     * \headerfile business_calendar.hpp
+     * Years which contain holidays are stored as one bitset of business days, one bit per day, with number of business days preceding every 64 bit word.
+     * Outside of these years only weekend days are taken into account and counts are computed in closed form, so all queries are independent of distance
+     * between dates: isBusinessDay and businessDaysBetween are O(1), addBusinessDays is O(log(n)) of number of stored years.
+     */
+    class BusinessCalendar {
+    public:
+        /**
+         * \brief Weekend days used by default constructor.
+         */
+        static constexpr std::array< std::chrono::weekday, 2 > default_weekend{std::chrono::Saturday, std::chrono::Sunday};
+
+        /**
+         * \brief Creates calendar without holidays.
+         * \param p_weekend std::span< const std::chrono::weekday > days of the week which are not business days.
+         * \throws std::invalid_argument - if all days of the week are weekend days or weekday is not valid.
+         */
+        explicit BusinessCalendar(std::span< const std::chrono::weekday > p_weekend = default_weekend);
+
+        /**
+         * \brief Marks date as holiday.
+         * \param p_date const Date&
+         */
+        void addHoliday(const Date& p_date);
+        /**
+         * \brief Marks dates as holidays.
+         * \note Bitset is rebuilt once per call, so loading list of holidays with one call is preferable.
+         * \param p_dates std::span< const Date >
+         */
+        void addHolidays(std::span< const Date > p_dates);
+
+        /**
+         * \brief Returns true if date is neither weekend day nor holiday.
+         * \param p_date const Date&
+         * \return bool
+         */
+        [[nodiscard]] auto isBusinessDay(const Date& p_date) const noexcept -> bool;
+        /**
+         * \brief Moves date by provided number of business days.
+         * \note Result is always a business day unless p_days is 0, in which case p_date is returned as is.
+         * \param p_date const Date&
+         * \param p_days int64_t, negative value moves date backwards.
+         * \return Date
+         */
+        [[nodiscard]] auto addBusinessDays(const Date& p_date, int64_t p_days) const -> Date;
+        /**
+         * \brief Returns number of business days in [p_from, p_to) range.
+         * \param p_from const Date&
+         * \param p_to const Date&
+         * \return int64_t, negative if p_to is earlier than p_from.
+         */
+        [[nodiscard]] auto businessDaysBetween(const Date& p_from, const Date& p_to) const noexcept -> int64_t;
+
+    private:
+        std::vector< uint64_t > m_bits;
+        std::vector< int64_t > m_ranks;
+        std::vector< int32_t > m_holidays;
+        std::array< int64_t, 8 > m_week_ranks{};
+        std::array< int32_t, 7 > m_week_days{};
+        int64_t m_week_length{0};
+        int64_t m_total{0};
+        int32_t m_begin{0};
+        int32_t m_end{0};
+        uint8_t m_weekend{0};
+
+        void rebuild();
+        /**
+         * \brief Returns number of business days between 1970-01-01 and p_day counting weekend days only.
+         */
+        [[nodiscard]] auto weekRank(int64_t p_day) const noexcept -> int64_t;
+        /**
+         * \brief Returns business day with provided weekRank.
+         */
+        [[nodiscard]] auto weekSelect(int64_t p_rank) const noexcept -> int64_t;
+        /**
+         * \brief Returns number of business days between m_begin and p_day, negative for days before m_begin.
+         */
+        [[nodiscard]] auto rank(int64_t p_day) const noexcept -> int64_t;
+        /**
+         * \brief Returns business day with provided rank.
+         */
+        [[nodiscard]] auto select(int64_t p_rank) const noexcept -> int64_t;
+    };
+
+}  // namespace mt::date
+
+#endif  //BUSINESS_CALENDAR_HPP
@@ -0,0 +1,75 @@
+#ifndef COARSE_CLOCK_HPP
+#define COARSE_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+
+namespace mt {
+
+    /**
+     * \brief Enum which represents source of current time used by now() functions.
+     * \li System - std::chrono::system_clock is read on each call.
+     * \li Coarse - CoarseClock is read on each call.
+     */
+    enum class ClockSource : uint8_t {
+        System,
+        Coarse,
+    };
+
+    /**
+     * \brief Clock which returns system time published by background thread at fixed tick.
+     * \headerfile coarse_clock.hpp
+     * Reading the clock is a single relaxed atomic load, so it is cheap and does not contend between threads,
+     * but the value may lag behind system_clock by up to one tick.
+     * \note If the clock is not started, now() falls back to std::chrono::system_clock.
+     * Satisfies Clock named requirement.
+     */
+    class CoarseClock {
+    public:
+        using duration = std::chrono::nanoseconds;
+        using rep = duration::rep;
+        using period = duration::period;
+        using time_point = std::chrono::time_point< std::chrono::system_clock, duration >;
+        static constexpr bool is_steady = false;
+
+        /**
+         * \brief Returns last published time.
+         * \return time_point
+         */
+        [[nodiscard]] static auto now() noexcept -> time_point;
+
+        /**
+         * \brief Starts background thread which publishes system time each p_tick.
+         * If the clock is already running, tick is changed starting from the next publication.
+         * \param p_tick std::chrono::nanoseconds
+         * \throws std::invalid_argument - if p_tick is not positive.
+         */
+        static void start(std::chrono::nanoseconds p_tick = std::chrono::milliseconds{1});
+
+        /**
+         * \brief Stops background thread. now() falls back to std::chrono::system_clock afterwards.
+         */
+        static void stop();
+
+        /**
+         * \brief Returns true if background thread is running.
+         * \return bool
+         */
+        [[nodiscard]] static auto isRunning() noexcept -> bool;
+    };
+
+    /**
+     * \brief Returns current system time read from provided source.
+     * \param p_clock ClockSource
+     * \return std::chrono::time_point< std::chrono::system_clock, std::chrono::nanoseconds >
+     */
+    [[nodiscard]] inline auto currentTime(const ClockSource p_clock) noexcept -> CoarseClock::time_point {
+        if (p_clock == ClockSource::Coarse) {
+            return CoarseClock::now();
+        }
+        return std::chrono::time_point_cast< std::chrono::nanoseconds >(std::chrono::system_clock::now());
+    }
+
+}  // namespace mt
+
+#endif  //COARSE_CLOCK_HPP
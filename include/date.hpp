@@ -2,9 +2,19 @@
 #define DATE_HPP
 
 #include "time_zones.hpp"
+#include "coarse_clock.hpp"
+#include "parser.hpp"
+#include "format_pattern.hpp"
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <chrono>
+#include <iterator>
+#include <expected>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <ostream>
 #include <functional>
 #include <random>
@@ -32,6 +42,10 @@ namespace mt::date {
         friend auto operator-(Date p_date, DateDuration p_value) -> Date;
 
     public:
+        /**
+         * \brief Maximal length of ISO standard representation.
+         */
+        static constexpr std::size_t max_string_length{iso_date_pattern.maxLength()};
         /**
          * \brief Default constructor.
          * Creates Date object which represent current date based on UTC time zone
@@ -65,6 +79,27 @@ namespace mt::date {
          * \throws std::range_error.
          */
         explicit Date(std::chrono::years p_years, std::chrono::months p_months, std::chrono::days p_days);
+        /**
+         * \overload
+         * \brief Overloaded constructor
+         * Creates Date object from std::chrono::year_month_day.
+         * \param p_date std::chrono::year_month_day.
+         * \throws std::range_error - if p_date is not a valid date.
+         */
+        constexpr explicit Date(const std::chrono::year_month_day p_date) {
+            if (not p_date.ok()) {
+                throw std::range_error("Bad [date] value was provided");
+            }
+            m_days = static_cast< int32_t >(std::chrono::sys_days{p_date}.time_since_epoch().count());
+        }
+        /**
+         * \overload
+         * \brief Overloaded constructor
+         * Creates Date object from number of days passed since 1970-01-01.
+         * \param p_days std::chrono::sys_days.
+         */
+        constexpr explicit Date(const std::chrono::sys_days p_days) noexcept :
+            m_days(static_cast< int32_t >(p_days.time_since_epoch().count())) { }
         /**
          * \overload
          * \brief Overloaded constructor
@@ -73,6 +108,13 @@ namespace mt::date {
          * \throws std::range_error - if date representation has invalid values.
          */
         explicit Date(const std::string& p_iso_date);
+        /**
+         * \brief Parses std::string_view representing the date in [YYYYMMDD] or [YYYY-MM-DD] formats.
+         * Unlike string constructor neither allocates nor throws.
+         * \param p_iso_date std::string_view.
+         * \return std::expected< Date, mt::parser::Error >.
+         */
+        [[nodiscard]] static auto tryParse(std::string_view p_iso_date) noexcept -> std::expected< Date, mt::parser::Error >;
         /**
          * \brief Copy constructor
          */
@@ -98,23 +140,35 @@ namespace mt::date {
          * \param other const Date&
          * \return bool
          */
-        auto operator==(const Date& other) const -> bool;
+        constexpr auto operator==(const Date& other) const -> bool { return m_days == other.m_days; }
         /**
          * \brief Operator <
          * \param other const Date&
          * \return bool
          */
-        auto operator<(const Date& other) const -> bool;
+        constexpr auto operator<(const Date& other) const -> bool { return m_days < other.m_days; }
         /**
          * \brief Adds specified value
          * \param p_value DateValue
          */
         void operator+=(DateDuration p_value);
+        /**
+         * \overload
+         * \brief Adds specified number of days.
+         * \param p_days std::chrono::days
+         */
+        constexpr void operator+=(const std::chrono::days p_days) noexcept { m_days += static_cast< int32_t >(p_days.count()); }
         /**
          * \brief Subtracts specified value
          * \param p_value DateValue
          */
         void operator-=(DateDuration p_value);
+        /**
+         * \overload
+         * \brief Subtracts specified number of days.
+         * \param p_days std::chrono::days
+         */
+        constexpr void operator-=(const std::chrono::days p_days) noexcept { m_days -= static_cast< int32_t >(p_days.count()); }
 
         /**
          * \brief Destructor
@@ -124,7 +178,12 @@ namespace mt::date {
          * \brief Returns currently set date.
          * \return std::chrono::year_month_day
          */
-        [[nodiscard]] auto date() const -> std::chrono::year_month_day;
+        [[nodiscard]] constexpr auto date() const -> std::chrono::year_month_day { return std::chrono::year_month_day{sinceEpoch()}; }
+        /**
+         * \brief Returns number of days passed since 1970-01-01.
+         * \return std::chrono::sys_days
+         */
+        [[nodiscard]] constexpr auto sinceEpoch() const noexcept -> std::chrono::sys_days { return std::chrono::sys_days{std::chrono::days{m_days}}; }
         /**
          * \brief Returns currently set day of the month.
          * \note This function returns actual, or otherworldly current, day of the months and not the total number of days passed in the month.
@@ -144,7 +203,7 @@ namespace mt::date {
          * \note This function returns actual, or otherworldly current, day of the week and not the total number of days passed in the week.
          * \return uint8_t.
          */
-        [[nodiscard]] auto weekDay() const -> std::chrono::weekday;
+        [[nodiscard]] constexpr auto weekDay() const -> std::chrono::weekday { return std::chrono::weekday{sinceEpoch()}; }
         /**
          * \brief Helper function to get month as an integer value (except bool)
          * \tparam OType output type
@@ -181,27 +240,103 @@ namespace mt::date {
             requires(std::is_integral_v< OType > && !std::same_as< bool, OType >)
         [[nodiscard]] auto year() const -> OType;
         /**
-         * \brief Generates string representation of date in ISO standard representation format. Or using provided formatter.
+         * \brief Generates string representation of date in ISO standard representation format.
          * \return std::string.
          */
-        [[nodiscard]] auto toString(const std::function< std::string(const Date&) >& formatter = {}) const -> std::string;
+        [[nodiscard]] auto toString() const -> std::string;
+        /**
+         * \overload
+         * \brief Generates string representation of date using provided pattern.
+         * \param p_pattern const FormatPattern&.
+         * \return std::string.
+         * \throws std::invalid_argument - if pattern contains time specifiers.
+         */
+        [[nodiscard]] auto toString(const FormatPattern& p_pattern) const -> std::string;
+        /**
+         * \overload
+         * \brief Generates string representation of date using provided formatter.
+         * If formatter is empty, default format is used.
+         * \return std::string.
+         */
+        [[deprecated("FormatPattern should be used instead")]] [[nodiscard]] auto toString(const std::function< std::string(const Date&) >& formatter) const
+            -> std::string;
+        /**
+         * \brief Writes ISO standard representation into [p_first, p_last) range without allocations.
+         * \param p_first char*
+         * \param p_last char*
+         * \return std::to_chars_result with pointer past the last written character, or std::errc::value_too_large if range is too small.
+         */
+        [[nodiscard]] auto toChars(char* p_first, char* p_last) const noexcept -> std::to_chars_result;
+        /**
+         * \overload
+         * \brief Writes representation built with provided pattern into [p_first, p_last) range without allocations.
+         * \param p_first char*
+         * \param p_last char*
+         * \param p_pattern const FormatPattern&
+         * \return std::to_chars_result with pointer past the last written character, std::errc::value_too_large if range is too small
+         * or std::errc::invalid_argument if pattern is not applicable.
+         */
+        [[nodiscard]] auto toChars(char* p_first, char* p_last, const FormatPattern& p_pattern) const noexcept -> std::to_chars_result;
+        /**
+         * \brief Writes ISO standard representation into output iterator without allocations.
+         * \tparam OutputIt output iterator type
+         * \param p_out OutputIt
+         * \return OutputIt past the last written character.
+         */
+        template < std::output_iterator< char > OutputIt >
+        auto formatTo(OutputIt p_out) const -> OutputIt;
+        /**
+         * \overload
+         * \brief Writes representation built with provided pattern into output iterator without allocations.
+         * \tparam OutputIt output iterator type
+         * \param p_out OutputIt
+         * \param p_pattern const FormatPattern&
+         * \return OutputIt past the last written character.
+         * \throws std::invalid_argument - if pattern is not applicable.
+         */
+        template < std::output_iterator< char > OutputIt >
+        auto formatTo(OutputIt p_out, const FormatPattern& p_pattern) const -> OutputIt;
         /**
          * \brief Creates Date object which represents local date.
          * \return Date.
          */
         [[nodiscard]] static auto localDate() -> Date;
+        /**
+         * \brief Creates Date object which represents current date in provided time zone.
+         * \param p_clock ClockSource, ClockSource::Coarse reads CoarseClock instead of system clock.
+         * \param p_time_zone TimeZone
+         * \return Date.
+         */
+        [[nodiscard]] static auto now(ClockSource p_clock = ClockSource::System, TimeZone p_time_zone = TimeZone::UTC) noexcept -> Date;
 
     private:
-        std::chrono::year_month_day m_date{};
+        int32_t m_days{0};
     };
 
+    template < std::output_iterator< char > OutputIt >
+    auto Date::formatTo(OutputIt p_out) const -> OutputIt {
+        std::array< char, max_string_length > buffer;
+        const auto [end, error] = toChars(buffer.data(), buffer.data() + buffer.size());
+        return std::copy(buffer.data(), end, p_out);
+    }
+
+    template < std::output_iterator< char > OutputIt >
+    auto Date::formatTo(OutputIt p_out, const FormatPattern& p_pattern) const -> OutputIt {
+        std::array< char, FormatPattern::max_formatted_length > buffer;
+        const auto [end, error] = toChars(buffer.data(), buffer.data() + buffer.size(), p_pattern);
+        if (error == std::errc::invalid_argument) {
+            throw std::invalid_argument("Format pattern with time specifiers can not be applied to Date");
+        }
+        return std::copy(buffer.data(), end, p_out);
+    }
+
     template < class OType >
         requires(std::is_integral_v< OType > && !std::same_as< bool, OType >)
     auto Date::monthDay() const -> OType {
         if constexpr (std::convertible_to< std::chrono::day, OType >) {
-            return static_cast< OType >(m_date.day());
+            return static_cast< OType >(monthDay());
         }
-        return static_cast< OType >(static_cast< uint32_t >(m_date.day()));
+        return static_cast< OType >(static_cast< uint32_t >(monthDay()));
     }
 
     template < class OType >
@@ -220,21 +355,22 @@ namespace mt::date {
         requires(std::is_integral_v< OType > && !std::same_as< bool, OType >)
     auto Date::month() const -> OType {
         if constexpr (std::convertible_to< std::chrono::month, OType >) {
-            return static_cast< OType >(m_date.month());
+            return static_cast< OType >(month());
         }
-        return static_cast< OType >(static_cast< uint32_t >(m_date.month()));
+        return static_cast< OType >(static_cast< uint32_t >(month()));
     }
 
     template < class OType >
         requires(std::is_integral_v< OType > && !std::same_as< bool, OType >)
     auto Date::year() const -> OType {
-        if (std::numeric_limits< OType >::max() <= static_cast<int32_t>(m_date.year()) || std::numeric_limits< OType >::min() >= static_cast<int32_t>(m_date.year())) {
+        const auto value = year();
+        if (std::numeric_limits< OType >::max() <= static_cast<int32_t>(value) || std::numeric_limits< OType >::min() >= static_cast<int32_t>(value)) {
             throw std::range_error("Output type can not represent storable value");
         }
         if constexpr (std::convertible_to< std::chrono::year, OType >) {
-            return static_cast< OType >(m_date.year());
+            return static_cast< OType >(value);
         }
-        return static_cast< OType >(static_cast< int32_t >(m_date.year()));
+        return static_cast< OType >(static_cast< int32_t >(value));
     }
 
     /**
@@ -279,6 +415,35 @@ namespace mt::date {
      * \return Date
      */
     auto operator-(Date p_date, DateDuration p_value) -> Date;
+    /**
+     * \overload
+     * \brief Adds number of days to date.
+     * \param p_date Date
+     * \param p_days std::chrono::days
+     * \return Date
+     */
+    constexpr auto operator+(Date p_date, const std::chrono::days p_days) noexcept -> Date {
+        p_date += p_days;
+        return p_date;
+    }
+    /**
+     * \overload
+     * \brief Subtracts number of days from date.
+     * \param p_date Date
+     * \param p_days std::chrono::days
+     * \return Date
+     */
+    constexpr auto operator-(Date p_date, const std::chrono::days p_days) noexcept -> Date {
+        p_date -= p_days;
+        return p_date;
+    }
+    /**
+     * \brief Returns number of days between two dates.
+     * \param l const Date&
+     * \param r const Date&
+     * \return std::chrono::days, negative if l is earlier than r.
+     */
+    constexpr auto operator-(const Date& l, const Date& r) noexcept -> std::chrono::days { return l.sinceEpoch() - r.sinceEpoch(); }
 
     auto operator<<(std::ostream& out, const Date& date) -> std::ostream&;
 }  //namespace mt::date
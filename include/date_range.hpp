@@ -0,0 +1,214 @@
+#ifndef DATE_RANGE_HPP
+#define DATE_RANGE_HPP
+
+#include "date_time.hpp"
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+
+namespace mt {
+
+    /**
+     * \brief Random access iterator which produces elements by index.
+     * \tparam Generator type which provides value_type and operator[](std::ptrdiff_t).
+     * \headerfile date_range.hpp
+     * \note Element is computed on dereference and returned by value. Generator is copied into the iterator,
+     * so iterators stay valid after the range they were obtained from is destroyed.
+     */
+    template < class Generator >
+    class IndexIterator {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = typename Generator::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        IndexIterator() = default;
+        constexpr IndexIterator(const Generator& p_generator, const difference_type p_index) noexcept :
+            m_generator(p_generator),
+            m_index(p_index) { }
+
+        [[nodiscard]] constexpr auto operator*() const -> value_type { return m_generator[m_index]; }
+        [[nodiscard]] constexpr auto operator[](const difference_type p_offset) const -> value_type { return m_generator[m_index + p_offset]; }
+
+        constexpr auto operator++() noexcept -> IndexIterator& {
+            ++m_index;
+            return *this;
+        }
+        constexpr auto operator++(int) noexcept -> IndexIterator {
+            auto previous = *this;
+            ++m_index;
+            return previous;
+        }
+        constexpr auto operator--() noexcept -> IndexIterator& {
+            --m_index;
+            return *this;
+        }
+        constexpr auto operator--(int) noexcept -> IndexIterator {
+            auto previous = *this;
+            --m_index;
+            return previous;
+        }
+        constexpr auto operator+=(const difference_type p_offset) noexcept -> IndexIterator& {
+            m_index += p_offset;
+            return *this;
+        }
+        constexpr auto operator-=(const difference_type p_offset) noexcept -> IndexIterator& {
+            m_index -= p_offset;
+            return *this;
+        }
+
+        [[nodiscard]] friend constexpr auto operator+(IndexIterator p_iterator, const difference_type p_offset) noexcept -> IndexIterator { return p_iterator += p_offset; }
+        [[nodiscard]] friend constexpr auto operator+(const difference_type p_offset, IndexIterator p_iterator) noexcept -> IndexIterator { return p_iterator += p_offset; }
+        [[nodiscard]] friend constexpr auto operator-(IndexIterator p_iterator, const difference_type p_offset) noexcept -> IndexIterator { return p_iterator -= p_offset; }
+        [[nodiscard]] friend constexpr auto operator-(const IndexIterator& l, const IndexIterator& r) noexcept -> difference_type { return l.m_index - r.m_index; }
+        [[nodiscard]] friend constexpr auto operator==(const IndexIterator& l, const IndexIterator& r) noexcept -> bool { return l.m_index == r.m_index; }
+        [[nodiscard]] friend constexpr auto operator<=>(const IndexIterator& l, const IndexIterator& r) noexcept -> std::strong_ordering { return l.m_index <=> r.m_index; }
+
+    private:
+        Generator m_generator{};
+        difference_type m_index{0};
+    };
+
+}  // namespace mt
+
+namespace mt::date {
+
+    /**
+     * \brief Random access view of dates from first to last, inclusive, with fixed step.
+     * \headerfile date_range.hpp
+     * Nth element is computed as first + n * step, so elements may be accessed in any order and range may be split between threads.
+     * Months and years steps are always applied to the first date, so end of the month clamping of Date arithmetic does not accumulate.
+     * \note Negative step produces descending range. Iterators do not refer to the range, so it is a borrowed range.
+     */
+    class DateRange : public std::ranges::view_interface< DateRange > {
+        /**
+         * \brief Computes elements, copied into iterators.
+         */
+        struct Generator {
+            using value_type = Date;
+
+            Date first;
+            int64_t step{1};
+            bool step_in_months{false};
+
+            [[nodiscard]] auto operator[](const std::ptrdiff_t p_index) const -> Date {
+                if (step_in_months) {
+                    return first + std::chrono::months{p_index * step};
+                }
+                return first + std::chrono::days{p_index * step};
+            }
+        };
+
+    public:
+        using value_type = Date;
+        using iterator = IndexIterator< Generator >;
+
+        /**
+         * \brief Creates range.
+         * \param p_first Date
+         * \param p_last Date, the last element is not later (not earlier for negative step) than p_last.
+         * \param p_step DateDuration
+         * \throws std::invalid_argument - if step is 0.
+         */
+        DateRange(Date p_first, Date p_last, DateDuration p_step = std::chrono::days{1});
+
+        [[nodiscard]] auto begin() const noexcept -> iterator { return iterator{m_generator, 0}; }
+        [[nodiscard]] auto end() const noexcept -> iterator { return iterator{m_generator, m_size}; }
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return static_cast< std::size_t >(m_size); }
+
+        /**
+         * \brief Returns element by index without bounds checking.
+         * \param p_index std::ptrdiff_t
+         * \return Date
+         */
+        [[nodiscard]] auto operator[](const std::ptrdiff_t p_index) const -> Date { return m_generator[p_index]; }
+        /**
+         * \brief Returns element by index.
+         * \param p_index std::size_t
+         * \return Date
+         * \throws std::out_of_range - if p_index is not less than size().
+         */
+        [[nodiscard]] auto at(std::size_t p_index) const -> Date;
+
+    private:
+        Generator m_generator;
+        std::ptrdiff_t m_size{0};
+    };
+
+}  // namespace mt::date
+
+namespace mt::date_time {
+
+    /**
+     * \brief Random access view of date times from first to last, inclusive, with fixed step.
+     * \headerfile date_range.hpp
+     * Nth element is computed as first + n * step, so elements may be accessed in any order and range may be split between threads.
+     * \note Elements are in the offset, or IANA time zone, of the first date time. Last is compared with elements as instant.
+     * Iterators do not refer to the range, so it is a borrowed range.
+     */
+    class DateTimeRange : public std::ranges::view_interface< DateTimeRange > {
+        /**
+         * \brief Computes elements, copied into iterators.
+         */
+        struct Generator {
+            using value_type = DateTime;
+
+            int64_t first{0};
+            int64_t step{1};
+            TimeZone offset{TimeZone::UTC};
+            ZoneId zone{ZoneId::None};
+
+            [[nodiscard]] auto operator[](const std::ptrdiff_t p_index) const -> DateTime {
+                const std::chrono::nanoseconds since_epoch{first + p_index * step};
+                return zone == ZoneId::None ? DateTime{since_epoch, offset} : DateTime{since_epoch, zone};
+            }
+        };
+
+    public:
+        using value_type = DateTime;
+        using iterator = IndexIterator< Generator >;
+
+        /**
+         * \brief Creates range.
+         * \param p_first const DateTime&
+         * \param p_last const DateTime&, the last element is not later (not earlier for negative step) than p_last.
+         * \param p_step time::TimeDuration
+         * \throws std::invalid_argument - if step is 0.
+         * \throws std::range_error - if first or last is out of std::chrono::nanoseconds since 1970-01-01 range.
+         * \throws std::length_error - if number of elements does not fit std::ptrdiff_t.
+         */
+        DateTimeRange(const DateTime& p_first, const DateTime& p_last, time::TimeDuration p_step);
+
+        [[nodiscard]] auto begin() const noexcept -> iterator { return iterator{m_generator, 0}; }
+        [[nodiscard]] auto end() const noexcept -> iterator { return iterator{m_generator, m_size}; }
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return static_cast< std::size_t >(m_size); }
+
+        /**
+         * \brief Returns element by index without bounds checking.
+         * \param p_index std::ptrdiff_t
+         * \return DateTime
+         */
+        [[nodiscard]] auto operator[](const std::ptrdiff_t p_index) const -> DateTime { return m_generator[p_index]; }
+        /**
+         * \brief Returns element by index.
+         * \param p_index std::size_t
+         * \return DateTime
+         * \throws std::out_of_range - if p_index is not less than size().
+         */
+        [[nodiscard]] auto at(std::size_t p_index) const -> DateTime;
+
+    private:
+        Generator m_generator;
+        std::ptrdiff_t m_size{0};
+    };
+
+}  // namespace mt::date_time
+
+template <> inline constexpr bool std::ranges::enable_borrowed_range< mt::date::DateRange > = true;
+template <> inline constexpr bool std::ranges::enable_borrowed_range< mt::date_time::DateTimeRange > = true;
+
+#endif  //DATE_RANGE_HPP
@@ -2,6 +2,7 @@
 #define DATE_TIME_HPP
 #include "date.hpp"
 #include "time.hpp"
+#include "zone_database.hpp"
 
 /**
  * \brief Namespace which unites date and time in one DateTime object
@@ -20,6 +21,10 @@ namespace mt::date_time {
         friend auto operator-(const DateTime& l, mt::time::TimeDuration) -> DateTime;
         friend auto operator-(const DateTime& l, mt::date::DateDuration) -> DateTime;
     public:
+        /**
+         * \brief Maximal length of ISO standard representation.
+         */
+        static constexpr std::size_t max_string_length{iso_date_time_pattern.maxLength()};
         /**
          * \brief Default constructor.
          * Creates DateTime based on UTC time zone
@@ -52,6 +57,47 @@ namespace mt::date_time {
          * \li [YYYY-MM-DDTHH:MM:SS.mmm.mmm.nnn+(-)HH]
          */
         explicit DateTime(const std::string& p_date_time);
+        /**
+         * \overload
+         * \brief Creates DateTime which represents provided instant in provided time zone.
+         * \param p_since_epoch std::chrono::nanoseconds since 1970-01-01T00:00:00Z
+         * \param p_time_zone TimeZone
+         */
+        explicit DateTime(std::chrono::nanoseconds p_since_epoch, TimeZone p_time_zone = TimeZone::UTC);
+        /**
+         * \overload
+         * \brief Creates DateTime which represents provided instant in IANA time zone.
+         * \param p_since_epoch std::chrono::nanoseconds since 1970-01-01T00:00:00Z
+         * \param p_zone ZoneId
+         * \throws std::out_of_range - if p_zone was not returned by ZoneDatabase::locate().
+         */
+        explicit DateTime(std::chrono::nanoseconds p_since_epoch, ZoneId p_zone);
+        /**
+         * \overload
+         * \brief Creates DateTime from local date and time in IANA time zone.
+         * \note Local time which is skipped by transition is moved forward by the length of the gap.
+         * \param p_date date::Date
+         * \param p_time time::Time local time, its offset is ignored.
+         * \param p_zone ZoneId
+         * \param p_choose Choose, which instant local time which happens twice represents.
+         * \throws std::out_of_range - if p_zone was not returned by ZoneDatabase::locate().
+         */
+        explicit DateTime(date::Date p_date, const time::Time& p_time, ZoneId p_zone, Choose p_choose = Choose::Earliest);
+        /**
+         * \brief Date and time constructor.
+         * \param p_date date::Date
+         * \param p_time time::Time
+         */
+        constexpr explicit DateTime(const date::Date p_date, const time::Time p_time) :
+            m_date(p_date),
+            m_time(p_time) { }
+        /**
+         * \brief Parses std::string_view representing date and time in formats accepted by string constructor.
+         * Unlike string constructor neither allocates nor throws.
+         * \param p_date_time std::string_view
+         * \return std::expected< DateTime, mt::parser::Error >
+         */
+        [[nodiscard]] static auto tryParse(std::string_view p_date_time) noexcept -> std::expected< DateTime, mt::parser::Error >;
         /**
          * \brief Copy constructor
          */
@@ -114,7 +160,7 @@ namespace mt::date_time {
          * \brief Returns date
          * \return const date::Date&
          */
-        [[nodiscard]] auto date() const -> const date::Date&;
+        [[nodiscard]] constexpr auto date() const -> const date::Date& { return m_date; }
         /**
          * \brief Returns date
          * \return date::Date&
@@ -124,7 +170,7 @@ namespace mt::date_time {
          * \brief Returns time
          * \return const time::Time&
          */
-        [[nodiscard]] auto time() const -> const time::Time&;
+        [[nodiscard]] constexpr auto time() const -> const time::Time& { return m_time; }
         /**
          * \brief Returns time
          * \return time::Time&
@@ -132,23 +178,100 @@ namespace mt::date_time {
         [[nodiscard]] auto time() -> time::Time&;
 
         /**
-         * \brief Generates string representation of date and time which is ISO standard representation. Or by formatter provided.
+         * \brief Generates string representation of date and time which is ISO standard representation.
+         * \return std::string
+         */
+        [[nodiscard]] auto toString() const -> std::string;
+        /**
+         * \overload
+         * \brief Generates string representation of date and time using provided pattern.
+         * \param p_pattern const FormatPattern&
+         * \return std::string
+         */
+        [[nodiscard]] auto toString(const FormatPattern& p_pattern) const -> std::string;
+        /**
+         * \overload
+         * \brief Generates string representation of date and time using provided formatter.
+         * If formatter is empty, default format is used.
          * \param formatter const std::function< std::string(const DateTime&) >
          * \return std::string
          */
-        [[nodiscard]] auto toString(const std::function< std::string(const DateTime&) >& formatter = {}) const -> std::string;
+        [[deprecated("FormatPattern should be used instead")]] [[nodiscard]] auto toString(const std::function< std::string(const DateTime&) >& formatter) const
+            -> std::string;
+        /**
+         * \brief Writes ISO standard representation into [p_first, p_last) range without allocations.
+         * \param p_first char*
+         * \param p_last char*
+         * \return std::to_chars_result with pointer past the last written character, or std::errc::value_too_large if range is too small.
+         */
+        [[nodiscard]] auto toChars(char* p_first, char* p_last) const noexcept -> std::to_chars_result;
+        /**
+         * \overload
+         * \brief Writes representation built with provided pattern into [p_first, p_last) range without allocations.
+         * \param p_first char*
+         * \param p_last char*
+         * \param p_pattern const FormatPattern&
+         * \return std::to_chars_result with pointer past the last written character, or std::errc::value_too_large if range is too small.
+         */
+        [[nodiscard]] auto toChars(char* p_first, char* p_last, const FormatPattern& p_pattern) const noexcept -> std::to_chars_result;
+        /**
+         * \brief Writes ISO standard representation into output iterator without allocations.
+         * \tparam OutputIt output iterator type
+         * \param p_out OutputIt
+         * \return OutputIt past the last written character.
+         */
+        template < std::output_iterator< char > OutputIt >
+        auto formatTo(OutputIt p_out) const -> OutputIt;
+        /**
+         * \overload
+         * \brief Writes representation built with provided pattern into output iterator without allocations.
+         * \tparam OutputIt output iterator type
+         * \param p_out OutputIt
+         * \param p_pattern const FormatPattern&
+         * \return OutputIt past the last written character.
+         */
+        template < std::output_iterator< char > OutputIt >
+        auto formatTo(OutputIt p_out, const FormatPattern& p_pattern) const -> OutputIt;
 
         /**
          * \brief Creates Date object which represents local date.
          * \return DateTime.
          */
         [[nodiscard]] static auto localDateTime() -> DateTime;
+        /**
+         * \brief Returns instant represented by DateTime as nanoseconds since 1970-01-01T00:00:00Z.
+         * \return std::chrono::nanoseconds
+         * \throws std::range_error - if instant does not fit std::chrono::nanoseconds.
+         */
+        [[nodiscard]] auto sinceEpoch() const -> std::chrono::nanoseconds;
+        /**
+         * \brief Creates DateTime object which represents current date and time in provided time zone.
+         * \note Clock is read once, so date and time always belong to the same instant.
+         * \param p_clock ClockSource, ClockSource::Coarse reads CoarseClock instead of system clock.
+         * \param p_time_zone TimeZone
+         * \return DateTime.
+         */
+        [[nodiscard]] static auto now(ClockSource p_clock = ClockSource::System, TimeZone p_time_zone = TimeZone::UTC) noexcept -> DateTime;
 
     private:
         date::Date m_date;
         time::Time m_time;
     };
 
+    template < std::output_iterator< char > OutputIt >
+    auto DateTime::formatTo(OutputIt p_out) const -> OutputIt {
+        std::array< char, max_string_length > buffer;
+        const auto [end, error] = toChars(buffer.data(), buffer.data() + buffer.size());
+        return std::copy(buffer.data(), end, p_out);
+    }
+
+    template < std::output_iterator< char > OutputIt >
+    auto DateTime::formatTo(OutputIt p_out, const FormatPattern& p_pattern) const -> OutputIt {
+        std::array< char, FormatPattern::max_formatted_length > buffer;
+        const auto [end, error] = toChars(buffer.data(), buffer.data() + buffer.size(), p_pattern);
+        return std::copy(buffer.data(), end, p_out);
+    }
+
     /**
      * \brief Operator !=
      * \param l const DateTime &
@@ -186,8 +309,18 @@ namespace mt::date_time {
      */
     auto operator<<(std::ostream& out, const DateTime& dt) -> std::ostream&;
 
+    /**
+     * \brief Operator +
+     * \note For date time in IANA time zone the offset is resolved again after arithmetic. Time durations move the instant,
+     * so wall clock follows daylight saving transitions, date durations move wall clock date, which is then resolved in the zone
+     * with Choose::Earliest and gap moving wall clock forward, same as DateTime(date::Date, const time::Time&, ZoneId) does.
+     */
     auto operator+(const DateTime& l, mt::time::TimeDuration) -> DateTime;
     auto operator+(const DateTime& l, mt::date::DateDuration) -> DateTime;
+    /**
+     * \brief Operator -
+     * \note Offset of date time in IANA time zone is resolved again, see operator+.
+     */
     auto operator-(const DateTime& l, mt::time::TimeDuration) -> DateTime;
     auto operator-(const DateTime& l, mt::date::DateDuration) -> DateTime;
 
@@ -0,0 +1,148 @@
+#ifndef DATE_TIME_COLUMN_HPP
+#define DATE_TIME_COLUMN_HPP
+
+#include "date_time.hpp"
+#include "time_zones.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace mt::batch {
+
+    /**
+     * \brief Container which stores date times column wise: days since 1970-01-01, nanoseconds since day start, UTC offsets and zones in separate arrays.
+     * \headerfile date_time_column.hpp
+     * Field accessors of Date and Time have bulk counterparts, which fill output array for all rows in one branch free loop
+     * compiled for AVX-512, AVX2 and baseline instruction sets with the variant chosen at load time.
+     * \note Date and time are stored as local values, the same way DateTime stores them. Exact UTC offset and IANA zone of each row are kept,
+     * so at() returns date time equal to the appended one.
+     */
+    class DateTimeColumn {
+    public:
+        /**
+         * \brief Default constructor. Creates empty column.
+         */
+        DateTimeColumn() = default;
+        /**
+         * \overload
+         * \brief Creates column from date times.
+         * \param p_date_times std::span< const date_time::DateTime >
+         */
+        explicit DateTimeColumn(std::span< const date_time::DateTime > p_date_times);
+
+        /**
+         * \brief Appends date time to the end of the column.
+         * \param p_date_time const date_time::DateTime&
+         */
+        void append(const date_time::DateTime& p_date_time);
+        /**
+         * \brief Reserves storage for p_rows rows.
+         * \param p_rows std::size_t
+         */
+        void reserve(std::size_t p_rows);
+        /**
+         * \brief Removes all rows.
+         */
+        void clear() noexcept;
+
+        /**
+         * \brief Returns number of rows.
+         * \return std::size_t
+         */
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return m_days.size(); }
+        /**
+         * \brief Returns true if column has no rows.
+         * \return bool
+         */
+        [[nodiscard]] auto empty() const noexcept -> bool { return m_days.empty(); }
+        /**
+         * \brief Returns row as DateTime.
+         * \param p_row std::size_t
+         * \return date_time::DateTime
+         * \throws std::out_of_range - if p_row is not less than size().
+         */
+        [[nodiscard]] auto at(std::size_t p_row) const -> date_time::DateTime;
+
+        /**
+         * \brief Returns days since 1970-01-01 column.
+         * \return std::span< const int32_t >
+         */
+        [[nodiscard]] auto days() const noexcept -> std::span< const int32_t > { return m_days; }
+        /**
+         * \brief Returns nanoseconds since day start column.
+         * \return std::span< const int64_t >
+         */
+        [[nodiscard]] auto sinceDayStart() const noexcept -> std::span< const int64_t > { return m_since_day_start; }
+        /**
+         * \brief Returns UTC offsets column in seconds.
+         * \return std::span< const int32_t >
+         */
+        [[nodiscard]] auto utcOffsets() const noexcept -> std::span< const int32_t > { return m_utc_offsets; }
+        /**
+         * \brief Returns zones column, ZoneId::None for rows with fixed offset.
+         * \return std::span< const ZoneId >
+         */
+        [[nodiscard]] auto zones() const noexcept -> std::span< const ZoneId > { return m_zones; }
+
+        /**
+         * \brief Bulk counterpart of Date::year.
+         * \param p_output std::span< int32_t > should have size() rows.
+         * \throws std::invalid_argument - if output size does not match.
+         */
+        void years(std::span< int32_t > p_output) const;
+        /**
+         * \brief Bulk counterpart of Date::month, months are numbered from 1.
+         * \param p_output std::span< uint8_t > should have size() rows.
+         * \throws std::invalid_argument - if output size does not match.
+         */
+        void months(std::span< uint8_t > p_output) const;
+        /**
+         * \brief Bulk counterpart of Date::monthDay.
+         * \param p_output std::span< uint8_t > should have size() rows.
+         * \throws std::invalid_argument - if output size does not match.
+         */
+        void monthDays(std::span< uint8_t > p_output) const;
+        /**
+         * \brief Bulk counterpart of Date::weekDay, days are encoded as by std::chrono::weekday::c_encoding, i.e. 0 is Sunday.
+         * \param p_output std::span< uint8_t > should have size() rows.
+         * \throws std::invalid_argument - if output size does not match.
+         */
+        void weekDays(std::span< uint8_t > p_output) const;
+        /**
+         * \brief Bulk counterpart of Date::isWeekend.
+         * \param p_output std::span< bool > should have size() rows.
+         * \throws std::invalid_argument - if output size does not match.
+         */
+        void isWeekend(std::span< bool > p_output) const;
+        /**
+         * \brief Bulk counterpart of Time::hours.
+         * \param p_output std::span< uint8_t > should have size() rows.
+         * \throws std::invalid_argument - if output size does not match.
+         */
+        void hours(std::span< uint8_t > p_output) const;
+        /**
+         * \brief Bulk counterpart of Time::minutes.
+         * \param p_output std::span< uint8_t > should have size() rows.
+         * \throws std::invalid_argument - if output size does not match.
+         */
+        void minutes(std::span< uint8_t > p_output) const;
+        /**
+         * \brief Bulk counterpart of Time::seconds.
+         * \param p_output std::span< uint8_t > should have size() rows.
+         * \throws std::invalid_argument - if output size does not match.
+         */
+        void seconds(std::span< uint8_t > p_output) const;
+
+    private:
+        std::vector< int32_t > m_days;
+        std::vector< int64_t > m_since_day_start;
+        std::vector< int32_t > m_utc_offsets;
+        std::vector< ZoneId > m_zones;
+
+        void checkOutput(std::size_t p_output_size) const;
+    };
+
+}  // namespace mt::batch
+
+#endif  //DATE_TIME_COLUMN_HPP
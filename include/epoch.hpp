@@ -0,0 +1,131 @@
+#ifndef EPOCH_HPP
+#define EPOCH_HPP
+
+#include "executor.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace mt::batch {
+
+    /**
+     * \brief Enum which represents resolution of Unix epoch values.
+     */
+    enum class EpochUnit : uint8_t {
+        Seconds,
+        Milliseconds,
+        Microseconds,
+        Nanoseconds,
+    };
+
+    /**
+     * \brief Returns number of ticks of provided unit in one day.
+     * \param p_unit EpochUnit
+     * \return int64_t
+     */
+    constexpr auto ticksPerDay(const EpochUnit p_unit) noexcept -> int64_t {
+        switch (p_unit) {
+            case EpochUnit::Seconds: {
+                return 86'400;
+            }
+            case EpochUnit::Milliseconds: {
+                return 86'400'000;
+            }
+            case EpochUnit::Microseconds: {
+                return 86'400'000'000;
+            }
+            case EpochUnit::Nanoseconds: {
+                break;
+            }
+        }
+        return 86'400'000'000'000;
+    }
+
+    /**
+     * \brief Civil date fields.
+     */
+    struct CivilDate {
+        int32_t year;
+        uint32_t month;
+        uint32_t day;
+    };
+
+    /**
+     * \brief Converts days since 1970-01-01 into civil date.
+     * \note Algorithm by H. Hinnant "chrono-Compatible Low-Level Date Algorithms", written without branches, so loops over it may be vectorized.
+     * \param p_days int32_t
+     * \return CivilDate
+     */
+    constexpr auto civilFromDays(const int32_t p_days) noexcept -> CivilDate {
+        const auto shifted = p_days + 719'468;
+        const auto era = (shifted >= 0 ? shifted : shifted - 146'096) / 146'097;
+        const auto day_of_era = static_cast< uint32_t >(shifted - era * 146'097);
+        const auto year_of_era = (day_of_era - day_of_era / 1'460 + day_of_era / 36'524 - day_of_era / 146'096) / 365;
+        const auto day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+        const auto shifted_month = (5 * day_of_year + 2) / 153;
+        const auto day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+        const auto month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+        return {static_cast< int32_t >(year_of_era) + era * 400 + static_cast< int32_t >(month <= 2), month, day};
+    }
+
+    /**
+     * \brief Converts civil date into days since 1970-01-01.
+     * \note Algorithm by H. Hinnant "chrono-Compatible Low-Level Date Algorithms", written without branches, so loops over it may be vectorized.
+     * \param p_date CivilDate
+     * \return int32_t
+     */
+    constexpr auto daysFromCivil(const CivilDate p_date) noexcept -> int32_t {
+        const auto year = p_date.year - static_cast< int32_t >(p_date.month <= 2);
+        const auto era = (year >= 0 ? year : year - 399) / 400;
+        const auto year_of_era = static_cast< uint32_t >(year - era * 400);
+        const auto day_of_year = (153 * (p_date.month > 2 ? p_date.month - 3 : p_date.month + 9) + 2) / 5 + p_date.day - 1;
+        const auto day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+        return era * 146'097 + static_cast< int32_t >(day_of_era) - 719'468;
+    }
+
+    /**
+     * \brief Output columns of epochToCivil and input columns of civilToEpoch.
+     * \note Each column should have the size of epoch column. Time of the day is stored in the unit of epoch values.
+     */
+    struct CivilColumns {
+        std::span< int32_t > years;
+        std::span< uint8_t > months;
+        std::span< uint8_t > days;
+        std::span< int64_t > since_day_start;
+    };
+
+    /**
+     * \brief Converts Unix epoch values into civil date and time of the day.
+     * \note Kernels are compiled for AVX-512, AVX2 and baseline instruction sets with the variant chosen at load time.
+     * \param p_epoch std::span< const int64_t >
+     * \param p_unit EpochUnit
+     * \param p_output const CivilColumns&
+     * \throws std::invalid_argument - if sizes of output columns do not match the input.
+     */
+    void epochToCivil(std::span< const int64_t > p_epoch, EpochUnit p_unit, const CivilColumns& p_output);
+    /**
+     * \overload
+     * \brief Converts rows in chunks run by p_executor.
+     * \param p_executor Executor&
+     */
+    void epochToCivil(Executor& p_executor, std::span< const int64_t > p_epoch, EpochUnit p_unit, const CivilColumns& p_output);
+
+    /**
+     * \brief Converts civil date and time of the day into Unix epoch values.
+     * \note Result is unspecified if it does not fit int64_t.
+     * \param p_input const CivilColumns&
+     * \param p_unit EpochUnit
+     * \param p_epoch std::span< int64_t >
+     * \throws std::invalid_argument - if sizes of input columns do not match the output.
+     */
+    void civilToEpoch(const CivilColumns& p_input, EpochUnit p_unit, std::span< int64_t > p_epoch);
+    /**
+     * \overload
+     * \brief Converts rows in chunks run by p_executor.
+     * \param p_executor Executor&
+     */
+    void civilToEpoch(Executor& p_executor, const CivilColumns& p_input, EpochUnit p_unit, std::span< int64_t > p_epoch);
+
+}  // namespace mt::batch
+
+#endif  //EPOCH_HPP
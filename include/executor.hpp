@@ -0,0 +1,85 @@
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace mt::batch {
+
+    /**
+     * \brief Pool of threads which runs loops over rows split into chunks.
+     * \headerfile executor.hpp
+     * Chunks are dealt to threads in contiguous runs, a thread which finishes its run steals chunks from the others,
+     * so uneven rows do not leave threads idle. Each chunk writes only its own rows, so results do not depend on scheduling.
+     * \note The calling thread takes part in the loop. Loops submitted from different threads run one after another,
+     * loops submitted from inside a chunk run in the calling thread.
+     */
+    class Executor {
+    public:
+        /**
+         * \brief Number of rows in one chunk by default. It is a multiple of 64, so chunks never share a word of validity bitmap.
+         */
+        static constexpr std::size_t default_chunk_rows{4096};
+
+        /**
+         * \brief Starts worker threads.
+         * \param p_threads std::size_t number of threads loops are run by, including the calling one. 0 means hardware concurrency.
+         */
+        explicit Executor(std::size_t p_threads = 0);
+        Executor(const Executor&) = delete;
+        Executor(Executor&&) = delete;
+        auto operator=(const Executor&) -> Executor& = delete;
+        auto operator=(Executor&&) -> Executor& = delete;
+        /**
+         * \brief Stops worker threads. Loop which is running is finished first.
+         */
+        ~Executor();
+
+        /**
+         * \brief Returns number of threads loops are run by, including the calling one.
+         * \return std::size_t
+         */
+        [[nodiscard]] auto threads() const noexcept -> std::size_t;
+
+        /**
+         * \brief Calls p_function(first, last) for each chunk [first, last) of [0, p_rows) and waits for all of them.
+         * \tparam Function callable with (std::size_t, std::size_t) arguments.
+         * \param p_rows std::size_t
+         * \param p_function Function&&
+         * \param p_chunk_rows std::size_t number of rows in one chunk, the last chunk may be shorter. 0 is treated as 1.
+         * \throws Exception thrown by p_function. Chunks which did not start yet are skipped then.
+         */
+        template < class Function >
+        void forEachChunk(std::size_t p_rows, Function&& p_function, std::size_t p_chunk_rows = default_chunk_rows);
+
+        /**
+         * \brief Returns executor shared by the library which uses all hardware threads.
+         * \return Executor&
+         */
+        [[nodiscard]] static auto shared() -> Executor&;
+
+    private:
+        struct State;
+        using Chunk = void (*)(const void*, std::size_t, std::size_t);
+
+        std::unique_ptr< State > m_state;
+
+        void run(std::size_t p_rows, std::size_t p_chunk_rows, Chunk p_chunk, const void* p_function);
+    };
+
+    template < class Function >
+    void Executor::forEachChunk(const std::size_t p_rows, Function&& p_function, const std::size_t p_chunk_rows) {
+        using Callable = std::remove_reference_t< Function >;
+        run(
+            p_rows,
+            p_chunk_rows,
+            [](const void* p_callable, const std::size_t p_first, const std::size_t p_last) {
+                (*static_cast< Callable* >(const_cast< void* >(p_callable)))(p_first, p_last);
+            },
+            static_cast< const void* >(std::addressof(p_function)));
+    }
+
+}  // namespace mt::batch
+
+#endif  //EXECUTOR_HPP
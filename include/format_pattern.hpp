@@ -0,0 +1,330 @@
+#ifndef FORMAT_PATTERN_HPP
+#define FORMAT_PATTERN_HPP
+
+#include "time_zones.hpp"
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+namespace mt {
+
+    /**
+     * \brief Class which represents strftime like pattern compiled into flat list of operations.
+     * \headerfile format_pattern.hpp
+     * Pattern is compiled once and may be reused for any number of format calls. Construction is constexpr, so literal patterns may be compiled at compile time.
+     * \par Supported specifiers:
+     * \li %Y - year, at least 4 digits.
+     * \li %m - month, 2 digits.
+     * \li %d - day of the month, 2 digits.
+     * \li %j - day of the year, 3 digits.
+     * \li %u - ISO day of the week, 1 (Monday) to 7 (Sunday).
+     * \li %F - equivalent to %Y-%m-%d.
+     * \li %H - hours, 2 digits.
+     * \li %M - minutes, 2 digits.
+     * \li %S - seconds, 2 digits.
+     * \li %f - fraction of the second, 9 digits. %Nf, where N is 1 to 9, truncates fraction to N digits.
+     * \li %T - equivalent to %H:%M:%S.
+     * \li %z - offset as +(-)HHMM.
+     * \li %Ez - offset as +(-)HH:MM.
+     * \li %Z - Z for UTC, +(-)HH:MM otherwise.
+     * \li %% - % character.
+     */
+    class FormatPattern {
+    public:
+        /**
+         * \brief Maximal number of operations pattern may be compiled into.
+         */
+        static constexpr std::size_t max_operations{32};
+        /**
+         * \brief Maximal total length of literal text pattern may contain.
+         */
+        static constexpr std::size_t max_literals_length{64};
+        /**
+         * \brief Upper bound of the length any pattern may be formatted into.
+         */
+        static constexpr std::size_t max_formatted_length{max_operations * 9 + max_literals_length};
+
+        /**
+         * \brief Enum which represents operation kinds.
+         */
+        enum class Specifier : uint8_t {
+            Literal,
+            Year,
+            Month,
+            Day,
+            DayOfYear,
+            WeekDay,
+            Hours,
+            Minutes,
+            Seconds,
+            Fraction,
+            Offset,
+            OffsetExtended,
+            OffsetDesignator,
+        };
+
+        /**
+         * \brief Single compiled operation.
+         * \li For Literal - position and length of the text in literals storage.
+         * \li For Fraction - number of digits in length.
+         */
+        struct Operation {
+            Specifier specifier{Specifier::Literal};
+            uint8_t position{0};
+            uint8_t length{0};
+        };
+
+        /**
+         * \brief Compiles pattern.
+         * \param p_pattern std::string_view
+         * \throws std::invalid_argument - if pattern contains unsupported specifier.
+         * \throws std::length_error - if pattern exceeds max_operations or max_literals_length.
+         */
+        constexpr explicit FormatPattern(std::string_view p_pattern);
+
+        /**
+         * \brief Returns upper bound of formatted string length.
+         * \return std::size_t
+         */
+        [[nodiscard]] constexpr auto maxLength() const noexcept -> std::size_t { return m_max_length; }
+
+        /**
+         * \brief Returns true if pattern contains date specifiers.
+         * \return bool
+         */
+        [[nodiscard]] constexpr auto usesDate() const noexcept -> bool { return m_uses_date; }
+
+        /**
+         * \brief Returns true if pattern contains time or offset specifiers.
+         * \return bool
+         */
+        [[nodiscard]] constexpr auto usesTime() const noexcept -> bool { return m_uses_time; }
+
+        /**
+         * \brief Returns compiled operations.
+         * \return std::span< const Operation >
+         */
+        [[nodiscard]] constexpr auto operations() const noexcept -> std::span< const Operation > { return {m_operations.data(), m_operations_count}; }
+
+        /**
+         * \brief Formats provided fields into [p_first, p_last) range.
+         * \param p_first char*
+         * \param p_last char*
+         * \param p_date std::chrono::year_month_day
+         * \param p_since_day_start std::chrono::nanoseconds
+         * \param p_offset std::chrono::seconds offset from UTC, which is not limited to whole hours. Seconds part is not written.
+         * \return std::to_chars_result with pointer past the last written character, or std::errc::value_too_large if range is too small.
+         */
+        auto format(char* p_first, char* p_last, std::chrono::year_month_day p_date, std::chrono::nanoseconds p_since_day_start, std::chrono::seconds p_offset) const noexcept
+            -> std::to_chars_result;
+        /**
+         * \overload
+         * \param p_offset TimeZone
+         */
+        auto format(char* p_first, char* p_last, std::chrono::year_month_day p_date, std::chrono::nanoseconds p_since_day_start, TimeZone p_offset) const noexcept
+            -> std::to_chars_result {
+            return format(p_first, p_last, p_date, p_since_day_start, std::chrono::hours{static_cast< int8_t >(p_offset)});
+        }
+
+    private:
+        std::array< Operation, max_operations > m_operations{};
+        std::array< char, max_literals_length > m_literals{};
+        std::size_t m_operations_count{0};
+        std::size_t m_literals_length{0};
+        std::size_t m_max_length{0};
+        bool m_uses_date{false};
+        bool m_uses_time{false};
+
+        constexpr void addOperation(Specifier p_specifier, uint8_t p_length = 0);
+        constexpr void addLiteral(char p_character);
+        /**
+         * \brief Formats into buffer which is known to hold at least maxLength() characters.
+         */
+        auto formatUnchecked(char* p_first, std::chrono::year_month_day p_date, std::chrono::nanoseconds p_since_day_start, std::chrono::seconds p_offset) const noexcept -> char*;
+    };
+
+    constexpr FormatPattern::FormatPattern(const std::string_view p_pattern) {
+        for (std::size_t i = 0; i < p_pattern.length(); ++i) {
+            if (p_pattern[i] != '%') {
+                addLiteral(p_pattern[i]);
+                continue;
+            }
+            if (++i == p_pattern.length()) {
+                throw std::invalid_argument("Format pattern ends with incomplete specifier");
+            }
+            switch (p_pattern[i]) {
+                case 'Y': {
+                    addOperation(Specifier::Year);
+                    break;
+                }
+                case 'm': {
+                    addOperation(Specifier::Month);
+                    break;
+                }
+                case 'd': {
+                    addOperation(Specifier::Day);
+                    break;
+                }
+                case 'j': {
+                    addOperation(Specifier::DayOfYear);
+                    break;
+                }
+                case 'u': {
+                    addOperation(Specifier::WeekDay);
+                    break;
+                }
+                case 'F': {
+                    addOperation(Specifier::Year);
+                    addLiteral('-');
+                    addOperation(Specifier::Month);
+                    addLiteral('-');
+                    addOperation(Specifier::Day);
+                    break;
+                }
+                case 'H': {
+                    addOperation(Specifier::Hours);
+                    break;
+                }
+                case 'M': {
+                    addOperation(Specifier::Minutes);
+                    break;
+                }
+                case 'S': {
+                    addOperation(Specifier::Seconds);
+                    break;
+                }
+                case 'T': {
+                    addOperation(Specifier::Hours);
+                    addLiteral(':');
+                    addOperation(Specifier::Minutes);
+                    addLiteral(':');
+                    addOperation(Specifier::Seconds);
+                    break;
+                }
+                case 'f': {
+                    addOperation(Specifier::Fraction, 9);
+                    break;
+                }
+                case 'z': {
+                    addOperation(Specifier::Offset);
+                    break;
+                }
+                case 'Z': {
+                    addOperation(Specifier::OffsetDesignator);
+                    break;
+                }
+                case 'E': {
+                    if (i + 1 == p_pattern.length() || p_pattern[i + 1] != 'z') {
+                        throw std::invalid_argument("Format pattern specifier E is supported only as %Ez");
+                    }
+                    ++i;
+                    addOperation(Specifier::OffsetExtended);
+                    break;
+                }
+                case '%': {
+                    addLiteral('%');
+                    break;
+                }
+                default: {
+                    if (p_pattern[i] >= '1' && p_pattern[i] <= '9' && i + 1 < p_pattern.length() && p_pattern[i + 1] == 'f') {
+                        addOperation(Specifier::Fraction, static_cast< uint8_t >(p_pattern[i] - '0'));
+                        ++i;
+                        break;
+                    }
+                    throw std::invalid_argument("Format pattern contains unsupported specifier");
+                }
+            }
+        }
+    }
+
+    constexpr void FormatPattern::addOperation(const Specifier p_specifier, const uint8_t p_length) {
+        if (m_operations_count == max_operations) {
+            throw std::length_error("Format pattern contains too many operations");
+        }
+        m_operations[m_operations_count++] = Operation{p_specifier, 0, p_length};
+        switch (p_specifier) {
+            case Specifier::Year: {
+                m_max_length += 6;
+                m_uses_date = true;
+                break;
+            }
+            case Specifier::Month:
+            case Specifier::Day: {
+                m_max_length += 2;
+                m_uses_date = true;
+                break;
+            }
+            case Specifier::DayOfYear: {
+                m_max_length += 3;
+                m_uses_date = true;
+                break;
+            }
+            case Specifier::WeekDay: {
+                m_max_length += 1;
+                m_uses_date = true;
+                break;
+            }
+            case Specifier::Hours:
+            case Specifier::Minutes:
+            case Specifier::Seconds: {
+                m_max_length += 2;
+                m_uses_time = true;
+                break;
+            }
+            case Specifier::Fraction: {
+                m_max_length += p_length;
+                m_uses_time = true;
+                break;
+            }
+            case Specifier::Offset: {
+                m_max_length += 5;
+                m_uses_time = true;
+                break;
+            }
+            case Specifier::OffsetExtended:
+            case Specifier::OffsetDesignator: {
+                m_max_length += 6;
+                m_uses_time = true;
+                break;
+            }
+            case Specifier::Literal: {
+                break;
+            }
+        }
+    }
+
+    constexpr void FormatPattern::addLiteral(const char p_character) {
+        if (m_literals_length == max_literals_length) {
+            throw std::length_error("Format pattern contains too long literal text");
+        }
+        // Adjacent literal characters are merged into one operation.
+        if (m_operations_count == 0 || m_operations[m_operations_count - 1].specifier != Specifier::Literal) {
+            addOperation(Specifier::Literal);
+            m_operations[m_operations_count - 1].position = static_cast< uint8_t >(m_literals_length);
+        }
+        m_literals[m_literals_length++] = p_character;
+        ++m_operations[m_operations_count - 1].length;
+        ++m_max_length;
+    }
+
+    /**
+     * \brief Pattern of default Date string representation.
+     */
+    inline constexpr FormatPattern iso_date_pattern{"%F"};
+    /**
+     * \brief Pattern of default Time string representation.
+     */
+    inline constexpr FormatPattern iso_time_pattern{"%T.%f%Z"};
+    /**
+     * \brief Pattern of default DateTime string representation.
+     */
+    inline constexpr FormatPattern iso_date_time_pattern{"%FT%T.%f%Z"};
+
+}  // namespace mt
+
+#endif  //FORMAT_PATTERN_HPP
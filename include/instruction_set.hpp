@@ -0,0 +1,27 @@
+#ifndef INSTRUCTION_SET_HPP
+#define INSTRUCTION_SET_HPP
+
+#include <cstdint>
+
+namespace mt {
+
+    /**
+     * \brief Enum which represents instruction sets vectorized code paths may dispatch to.
+     * \note Values are ordered, so greater value means wider instruction set.
+     */
+    enum class InstructionSet : uint8_t {
+        Scalar,
+        SSE42,
+        AVX2,
+    };
+
+    /**
+     * \brief Returns widest instruction set supported by the running CPU.
+     * \note Detection is performed once, on the first call.
+     * \return InstructionSet
+     */
+    [[nodiscard]] auto supportedInstructionSet() noexcept -> InstructionSet;
+
+}  // namespace mt
+
+#endif  //INSTRUCTION_SET_HPP
@@ -0,0 +1,194 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include "instrumentation_config.hpp"
+#include "parser.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * \brief Namespace which includes opt-in counters of hot paths.
+ * Counters are compiled in only if the library is configured with ENABLE_INSTRUMENTATION, which defines DATE_TIME_INSTRUMENTATION
+ * in generated instrumentation_config.hpp, so the library and its consumers always agree on the setting.
+ * Otherwise recording functions are empty and snapshot() returns zeros.
+ */
+namespace mt::instrumentation {
+
+#if defined DATE_TIME_INSTRUMENTATION
+    constexpr bool enabled{true};
+#else
+    constexpr bool enabled{false};
+#endif
+
+    /**
+     * \brief Enum which represents counted events.
+     * \li DateParses, TimeParses, DateTimeParses - string constructors and tryParse calls.
+     * \li DateInvalidArgument, DateRangeError, TimeInvalidArgument, TimeRangeError, DateTimeRuntimeError - exceptions thrown by constructors.
+     * \li StringAllocations - strings allocated by toString.
+     * \li ClockReads - system clock reads of the constructors which take the current time.
+     * \li LocaltimeCalls - localtime_r calls made to resolve local offset.
+     */
+    enum class Counter : uint8_t {
+        DateParses,
+        TimeParses,
+        DateTimeParses,
+        DateInvalidArgument,
+        DateRangeError,
+        TimeInvalidArgument,
+        TimeRangeError,
+        DateTimeRuntimeError,
+        StringAllocations,
+        ClockReads,
+        LocaltimeCalls,
+    };
+
+    /**
+     * \brief Enum which represents timed operations.
+     */
+    enum class Histogram : uint8_t {
+        DateParse,
+        TimeParse,
+        DateTimeParse,
+    };
+
+    constexpr std::size_t counters_count{static_cast< std::size_t >(Counter::LocaltimeCalls) + 1};
+    constexpr std::size_t failure_reasons_count{static_cast< std::size_t >(parser::ErrorCode::InvalidOffset) + 1};
+    constexpr std::size_t histograms_count{static_cast< std::size_t >(Histogram::DateTimeParse) + 1};
+    /**
+     * \brief Number of buckets in a histogram. Bucket i holds durations of [2^(i-1), 2^i) cycles, bucket 0 holds zero durations.
+     */
+    constexpr std::size_t histogram_buckets{64};
+
+    /**
+     * \brief Counters of all threads summed up, including the threads which exited.
+     */
+    struct Snapshot {
+        std::array< uint64_t, counters_count > counters{};
+        /**
+         * \brief Parse failures indexed by parser::ErrorCode.
+         */
+        std::array< uint64_t, failure_reasons_count > parse_failures{};
+        std::array< std::array< uint64_t, histogram_buckets >, histograms_count > histograms{};
+
+        [[nodiscard]] constexpr auto counter(const Counter p_counter) const -> uint64_t { return counters[static_cast< std::size_t >(p_counter)]; }
+
+        [[nodiscard]] constexpr auto parseFailures(const parser::ErrorCode p_reason) const -> uint64_t { return parse_failures[static_cast< std::size_t >(p_reason)]; }
+
+        [[nodiscard]] constexpr auto histogram(const Histogram p_histogram) const -> const std::array< uint64_t, histogram_buckets >& {
+            return histograms[static_cast< std::size_t >(p_histogram)];
+        }
+    };
+
+    namespace detail {
+        void count(Counter p_counter) noexcept;
+        void countFailure(parser::ErrorCode p_reason) noexcept;
+        [[nodiscard]] auto histogramsEnabled() noexcept -> bool;
+        [[nodiscard]] auto cycles() noexcept -> uint64_t;
+        void record(Histogram p_histogram, uint64_t p_cycles) noexcept;
+    }  // namespace detail
+
+    /**
+     * \brief Increments p_counter of the calling thread.
+     * \param p_counter Counter
+     */
+    inline void count(const Counter p_counter) noexcept {
+        if constexpr (enabled) {
+            detail::count(p_counter);
+        }
+    }
+
+    /**
+     * \brief Increments parse failures of the calling thread with p_reason.
+     * \param p_reason parser::ErrorCode
+     */
+    inline void countFailure(const parser::ErrorCode p_reason) noexcept {
+        if constexpr (enabled) {
+            detail::countFailure(p_reason);
+        }
+    }
+
+    /**
+     * \brief Increments p_exception counter and parse failures with p_reason of the calling thread, called before a parse failure is thrown.
+     * \param p_exception Counter of the exception type.
+     * \param p_reason parser::ErrorCode
+     */
+    inline void countThrow(const Counter p_exception, const parser::ErrorCode p_reason) noexcept {
+        if constexpr (enabled) {
+            detail::count(p_exception);
+            detail::countFailure(p_reason);
+        }
+    }
+
+    /**
+     * \brief Records cycles elapsed between construction and destruction into the histogram, if histograms are enabled.
+     * \headerfile instrumentation.hpp
+     */
+    class CycleTimer {
+    public:
+        explicit CycleTimer(const Histogram p_histogram) noexcept :
+            m_histogram(p_histogram) {
+            if constexpr (enabled) {
+                if (detail::histogramsEnabled()) {
+                    m_start = detail::cycles();
+                }
+            }
+        }
+        CycleTimer(const CycleTimer&) = delete;
+        CycleTimer(CycleTimer&&) = delete;
+        auto operator=(const CycleTimer&) -> CycleTimer& = delete;
+        auto operator=(CycleTimer&&) -> CycleTimer& = delete;
+
+        ~CycleTimer() {
+            if constexpr (enabled) {
+                if (m_start != 0) {
+                    detail::record(m_histogram, detail::cycles() - m_start);
+                }
+            }
+        }
+
+    private:
+        Histogram m_histogram;
+        uint64_t m_start{0};
+    };
+
+    /**
+     * \brief Enables or disables cycle histograms. Histograms are disabled by default, since reading cycle counter costs more than counting.
+     * \param p_enabled bool
+     */
+    void enableHistograms(bool p_enabled) noexcept;
+
+    /**
+     * \brief Returns sum of counters of all threads.
+     * \note Counters are read while other threads update them, so the snapshot is not atomic across counters.
+     * \return Snapshot
+     */
+    [[nodiscard]] auto snapshot() -> Snapshot;
+
+    /**
+     * \brief Sets counters of all threads to zero.
+     * \note Events recorded concurrently with the reset may be lost.
+     */
+    void reset();
+
+    /**
+     * \brief Returns name of p_counter, suitable as metric name.
+     * \param p_counter Counter
+     * \return std::string_view
+     */
+    [[nodiscard]] auto name(Counter p_counter) noexcept -> std::string_view;
+    /**
+     * \overload
+     * \param p_reason parser::ErrorCode
+     */
+    [[nodiscard]] auto name(parser::ErrorCode p_reason) noexcept -> std::string_view;
+    /**
+     * \overload
+     * \param p_histogram Histogram
+     */
+    [[nodiscard]] auto name(Histogram p_histogram) noexcept -> std::string_view;
+
+}  // namespace mt::instrumentation
+
+#endif  //INSTRUMENTATION_HPP
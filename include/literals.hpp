@@ -0,0 +1,54 @@
+#ifndef LITERALS_HPP
+#define LITERALS_HPP
+
+#include "date_time.hpp"
+#include "parser.hpp"
+
+#include <stdexcept>
+#include <string_view>
+
+/**
+ * \brief Namespace which includes user defined literals for Date, Time and DateTime
+ * \note Literals are parsed and validated at compile time with the rules of tryParse, so invalid literal is a compile error.
+ */
+namespace mt::literals {
+
+    /**
+     * \brief Creates Date from [YYYYMMDD] or [YYYY-MM-DD] literal, e.g. "2024-02-29"_date.
+     * \return date::Date
+     */
+    consteval auto operator""_date(const char* p_date, const std::size_t p_length) -> date::Date {
+        const auto date = parser::parseDate(std::string_view{p_date, p_length});
+        if (not date) {
+            throw std::invalid_argument("Invalid date literal");
+        }
+        return date::Date{*date};
+    }
+
+    /**
+     * \brief Creates Time from literal in formats accepted by Time::tryParse, e.g. "13:45:00.250"_time.
+     * \return time::Time
+     */
+    consteval auto operator""_time(const char* p_time, const std::size_t p_length) -> time::Time {
+        const auto time = parser::parseTime(std::string_view{p_time, p_length});
+        if (not time) {
+            throw std::invalid_argument("Invalid time literal");
+        }
+        return time::Time{time->since_day_start, time->offset};
+    }
+
+    /**
+     * \brief Creates DateTime from literal in formats accepted by DateTime::tryParse, e.g. "2024-02-29T13:45:00Z"_dt.
+     * \return date_time::DateTime
+     */
+    consteval auto operator""_dt(const char* p_date_time, const std::size_t p_length) -> date_time::DateTime {
+        const auto date_time = parser::parseDateTime(std::string_view{p_date_time, p_length});
+        if (not date_time) {
+            throw std::invalid_argument("Invalid date time literal");
+        }
+        return date_time::DateTime{date::Date{date_time->date}, time::Time{date_time->time.since_day_start, date_time->time.offset}};
+    }
+
+}  // namespace mt::literals
+
+#endif  //LITERALS_HPP
@@ -0,0 +1,105 @@
+#ifndef PACKED_DATE_TIME_HPP
+#define PACKED_DATE_TIME_HPP
+
+#include "date_time.hpp"
+#include "time_zones.hpp"
+
+#include <chrono>
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+namespace mt::date_time {
+
+    /**
+     * \brief Class which stores an instant as one 64 bit count of nanoseconds since 1970-01-01T00:00:00Z.
+     * \headerfile packed_date_time.hpp
+     * Intended for dense storage of large amounts of timestamps: comparison and hashing are single integer operations.
+     * \note Unlike DateTime, the value is an instant and does not store time zone offset: full 64 bits are required by nanosecond resolution,
+     * so the offset is applied on construction from DateTime and requested back in toDateTime.
+     * Supported range is [1677-09-21T00:12:44Z, 2262-04-11T23:47:16Z].
+     */
+    class PackedDateTime {
+    public:
+        /**
+         * \brief Default constructor. Creates 1970-01-01T00:00:00Z.
+         */
+        constexpr PackedDateTime() noexcept = default;
+        /**
+         * \overload
+         * \brief Creates PackedDateTime from time point.
+         * \param p_time_point std::chrono::sys_time< std::chrono::nanoseconds >
+         */
+        constexpr explicit PackedDateTime(const std::chrono::sys_time< std::chrono::nanoseconds > p_time_point) noexcept :
+            m_nanoseconds(p_time_point.time_since_epoch().count()) { }
+        /**
+         * \overload
+         * \brief Creates PackedDateTime which represents the same instant as provided DateTime.
+         * \param p_date_time const DateTime&
+         * \throws std::range_error - if DateTime is out of supported range.
+         */
+        constexpr explicit PackedDateTime(const DateTime& p_date_time);
+
+        /**
+         * \brief Returns nanoseconds since Unix epoch.
+         * \return std::chrono::nanoseconds
+         */
+        [[nodiscard]] constexpr auto sinceEpoch() const noexcept -> std::chrono::nanoseconds { return std::chrono::nanoseconds{m_nanoseconds}; }
+        /**
+         * \brief Returns time point.
+         * \return std::chrono::sys_time< std::chrono::nanoseconds >
+         */
+        [[nodiscard]] constexpr auto timePoint() const noexcept -> std::chrono::sys_time< std::chrono::nanoseconds > {
+            return std::chrono::sys_time< std::chrono::nanoseconds >{sinceEpoch()};
+        }
+        /**
+         * \brief Creates DateTime which represents the same instant in provided time zone.
+         * \param p_time_zone TimeZone
+         * \return DateTime
+         */
+        [[nodiscard]] constexpr auto toDateTime(TimeZone p_time_zone = TimeZone::UTC) const -> DateTime;
+
+        constexpr auto operator==(const PackedDateTime&) const noexcept -> bool = default;
+        constexpr auto operator<=>(const PackedDateTime&) const noexcept -> std::strong_ordering = default;
+
+    private:
+        int64_t m_nanoseconds{0};
+    };
+
+    static_assert(sizeof(PackedDateTime) == sizeof(int64_t) && std::is_trivially_copyable_v< PackedDateTime >);
+
+    constexpr PackedDateTime::PackedDateTime(const DateTime& p_date_time) {
+        // Seconds can not overflow for any year_month_day, so range is checked before nanoseconds are added.
+        const auto seconds = p_date_time.date().sinceEpoch().time_since_epoch()
+                           + std::chrono::floor< std::chrono::seconds >(p_date_time.time().sinceDayStart())
+                           - p_date_time.time().utcOffset();
+        constexpr auto min_seconds = std::chrono::ceil< std::chrono::seconds >(std::chrono::nanoseconds::min()) + std::chrono::seconds{1};
+        constexpr auto max_seconds = std::chrono::floor< std::chrono::seconds >(std::chrono::nanoseconds::max()) - std::chrono::seconds{1};
+        if (seconds < min_seconds || seconds > max_seconds) {
+            throw std::range_error("mt::date_time::PackedDateTime: DateTime is out of supported range");
+        }
+        const auto fraction = p_date_time.time().sinceDayStart() - std::chrono::floor< std::chrono::seconds >(p_date_time.time().sinceDayStart());
+        m_nanoseconds = (std::chrono::nanoseconds{seconds} + fraction).count();
+    }
+
+    constexpr auto PackedDateTime::toDateTime(const TimeZone p_time_zone) const -> DateTime {
+        const auto days = std::chrono::floor< std::chrono::days >(timePoint());
+        // Offset is added to time of the day, so the value can not overflow at the ends of the range.
+        auto since_day_start = timePoint() - days + std::chrono::hours{static_cast< int8_t >(p_time_zone)};
+        const auto carry = std::chrono::floor< std::chrono::days >(since_day_start);
+        since_day_start -= carry;
+        return DateTime{date::Date{days + carry}, time::Time{since_day_start, p_time_zone}};
+    }
+
+}  // namespace mt::date_time
+
+template <>
+struct std::hash< mt::date_time::PackedDateTime > {
+    auto operator()(const mt::date_time::PackedDateTime& p_date_time) const noexcept -> std::size_t {
+        return std::hash< int64_t >{}(p_date_time.sinceEpoch().count());
+    }
+};
+
+#endif  //PACKED_DATE_TIME_HPP
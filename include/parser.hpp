@@ -0,0 +1,246 @@
+#ifndef PARSER_HPP
+#define PARSER_HPP
+
+#include "time_zones.hpp"
+#include "instruction_set.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <string_view>
+
+/**
+ * \brief Namespace which includes allocation and exception free parsing primitives shared by Date, Time and DateTime
+ */
+namespace mt::parser {
+
+    /**
+     * \brief Enum which represents possible parse failures.
+     */
+    enum class ErrorCode : uint8_t {
+        InvalidLength,
+        InvalidCharacter,
+        InvalidMonth,
+        InvalidDay,
+        InvalidHours,
+        InvalidMinutes,
+        InvalidSeconds,
+        InvalidOffset,
+    };
+
+    /**
+     * \brief Describes parse failure.
+     */
+    struct Error {
+        /**
+         * \brief Failure reason
+         */
+        ErrorCode code;
+        /**
+         * \brief Byte position in the input where the failure was detected
+         */
+        std::size_t position;
+
+        constexpr auto operator==(const Error&) const -> bool = default;
+    };
+
+    /**
+     * \brief Fields decoded from time representation.
+     */
+    struct TimeFields {
+        std::chrono::nanoseconds since_day_start;
+        TimeZone offset;
+    };
+
+    /**
+     * \brief Fields decoded from date and time representation.
+     */
+    struct DateTimeFields {
+        std::chrono::year_month_day date;
+        TimeFields time;
+    };
+
+    namespace detail {
+        /**
+         * \brief Decodes p_count decimal digits starting at p_pos.
+         * \return Decoded value or Error pointing to the first non digit character.
+         */
+        constexpr auto decodeDigits(const std::string_view p_input, const std::size_t p_pos, const std::size_t p_count) noexcept -> std::expected< uint32_t, Error > {
+            uint32_t value = 0;
+            for (std::size_t i = p_pos; i < p_pos + p_count; ++i) {
+                const auto digit = static_cast< uint32_t >(static_cast< unsigned char >(p_input[i]) - '0');
+                if (digit > 9) {
+                    return std::unexpected(Error{ErrorCode::InvalidCharacter, i});
+                }
+                value = value * 10 + digit;
+            }
+            return value;
+        }
+
+        constexpr auto expectCharacter(const std::string_view p_input, const std::size_t p_pos, const char p_character) noexcept -> std::expected< void, Error > {
+            if (p_input[p_pos] != p_character) {
+                return std::unexpected(Error{ErrorCode::InvalidCharacter, p_pos});
+            }
+            return {};
+        }
+
+        constexpr auto withOffset(Error p_error, const std::size_t p_offset) noexcept -> Error {
+            p_error.position += p_offset;
+            return p_error;
+        }
+    }  // namespace detail
+
+    /**
+     * \brief Parses date represented in [YYYYMMDD] or [YYYY-MM-DD] formats.
+     * \param p_iso_date std::string_view.
+     * \return std::expected< std::chrono::year_month_day, Error >
+     */
+    constexpr auto parseDate(const std::string_view p_iso_date) noexcept -> std::expected< std::chrono::year_month_day, Error > {
+        const auto length = p_iso_date.length();
+        if (length != 8 && length != 10) {
+            return std::unexpected(Error{ErrorCode::InvalidLength, length});
+        }
+        const std::size_t month_pos = length == 8 ? 4 : 5;
+        const std::size_t day_pos = length == 8 ? 6 : 8;
+        if (length == 10) {
+            if (auto result = detail::expectCharacter(p_iso_date, 4, '-'); not result) {
+                return std::unexpected(result.error());
+            }
+            if (auto result = detail::expectCharacter(p_iso_date, 7, '-'); not result) {
+                return std::unexpected(result.error());
+            }
+        }
+        const auto year = detail::decodeDigits(p_iso_date, 0, 4);
+        if (not year) {
+            return std::unexpected(year.error());
+        }
+        const auto month = detail::decodeDigits(p_iso_date, month_pos, 2);
+        if (not month) {
+            return std::unexpected(month.error());
+        }
+        const auto day = detail::decodeDigits(p_iso_date, day_pos, 2);
+        if (not day) {
+            return std::unexpected(day.error());
+        }
+        const std::chrono::year_month_day date{std::chrono::year{static_cast< int32_t >(*year)}, std::chrono::month{*month}, std::chrono::day{*day}};
+        if (not date.month().ok()) {
+            return std::unexpected(Error{ErrorCode::InvalidMonth, month_pos});
+        }
+        if (not date.ok()) {
+            return std::unexpected(Error{ErrorCode::InvalidDay, day_pos});
+        }
+        return date;
+    }
+
+    /**
+     * \brief Parses time represented in formats accepted by mt::time::Time(const std::string&).
+     * \note In addition to [+(-)HH] offset, [+(-)HH:00] and [Z] offsets are accepted, so the output of Time::toString() can be parsed back.
+     * \param p_time std::string_view.
+     * \return std::expected< TimeFields, Error >
+     */
+    constexpr auto parseTime(const std::string_view p_time) noexcept -> std::expected< TimeFields, Error > {
+        auto length = p_time.length();
+        TimeFields fields{std::chrono::nanoseconds{0}, TimeZone::UTC};
+        if (length > 0 && p_time[length - 1] == 'Z') {
+            length -= 1;
+        } else if (length >= 6 && p_time[length - 3] == ':' && (p_time[length - 6] == '+' || p_time[length - 6] == '-')) {
+            const auto hours = detail::decodeDigits(p_time, length - 5, 2);
+            if (not hours) {
+                return std::unexpected(hours.error());
+            }
+            const auto minutes = detail::decodeDigits(p_time, length - 2, 2);
+            if (not minutes) {
+                return std::unexpected(minutes.error());
+            }
+            if (*hours > 12 || *minutes != 0) {
+                return std::unexpected(Error{ErrorCode::InvalidOffset, length - 6});
+            }
+            fields.offset = static_cast< TimeZone >(p_time[length - 6] == '-' ? -static_cast< int8_t >(*hours) : static_cast< int8_t >(*hours));
+            length -= 6;
+        } else if (length >= 3 && (p_time[length - 3] == '+' || p_time[length - 3] == '-')) {
+            const auto hours = detail::decodeDigits(p_time, length - 2, 2);
+            if (not hours) {
+                return std::unexpected(hours.error());
+            }
+            if (*hours > 12) {
+                return std::unexpected(Error{ErrorCode::InvalidOffset, length - 3});
+            }
+            fields.offset = static_cast< TimeZone >(p_time[length - 3] == '-' ? -static_cast< int8_t >(*hours) : static_cast< int8_t >(*hours));
+            length -= 3;
+        }
+        if (length != 5 && length != 8 && length != 12 && length != 16 && length != 20) {
+            return std::unexpected(Error{ErrorCode::InvalidLength, length});
+        }
+
+        constexpr std::size_t separators_pos[]{2, 5, 8, 12, 16};
+        constexpr char separators[]{':', ':', '.', '.', '.'};
+        constexpr std::size_t fields_pos[]{0, 3, 6, 9, 13, 17};
+        constexpr std::size_t fields_width[]{2, 2, 2, 3, 3, 3};
+        constexpr int64_t fields_scale[]{3'600'000'000'000, 60'000'000'000, 1'000'000'000, 1'000'000, 1'000, 1};
+        constexpr uint32_t fields_max[]{23, 59, 59, 999, 999, 999};
+        constexpr ErrorCode fields_error[]{ErrorCode::InvalidHours, ErrorCode::InvalidMinutes, ErrorCode::InvalidSeconds};
+
+        int64_t nanoseconds = 0;
+        for (std::size_t i = 0; i < 6 && fields_pos[i] < length; ++i) {
+            if (i > 0) {
+                if (auto result = detail::expectCharacter(p_time, separators_pos[i - 1], separators[i - 1]); not result) {
+                    return std::unexpected(result.error());
+                }
+            }
+            const auto value = detail::decodeDigits(p_time, fields_pos[i], fields_width[i]);
+            if (not value) {
+                return std::unexpected(value.error());
+            }
+            if (*value > fields_max[i]) {
+                return std::unexpected(Error{fields_error[i], fields_pos[i]});
+            }
+            nanoseconds += *value * fields_scale[i];
+        }
+        fields.since_day_start = std::chrono::nanoseconds{nanoseconds};
+        return fields;
+    }
+
+    /**
+     * \brief Parses date and time represented in formats accepted by mt::date_time::DateTime(const std::string&).
+     * \param p_date_time std::string_view.
+     * \return std::expected< DateTimeFields, Error >
+     */
+    constexpr auto parseDateTime(const std::string_view p_date_time) noexcept -> std::expected< DateTimeFields, Error > {
+        const std::size_t date_length = p_date_time.length() > 4 && p_date_time[4] == '-' ? 10 : 8;
+        if (p_date_time.length() <= date_length) {
+            return std::unexpected(Error{ErrorCode::InvalidLength, p_date_time.length()});
+        }
+        if (auto result = detail::expectCharacter(p_date_time, date_length, 'T'); not result) {
+            return std::unexpected(result.error());
+        }
+        const auto date = parseDate(p_date_time.substr(0, date_length));
+        if (not date) {
+            return std::unexpected(date.error());
+        }
+        const auto time = parseTime(p_date_time.substr(date_length + 1));
+        if (not time) {
+            return std::unexpected(detail::withOffset(time.error(), date_length + 1));
+        }
+        return DateTimeFields{*date, *time};
+    }
+
+    /**
+     * \brief Vectorized version of parseDateTime.
+     * Fixed width layouts are validated and decoded with SIMD instructions of the widest instruction set supported by the CPU.
+     * Inputs which do not match any of the layouts, as well as invalid inputs, are handed over to parseDateTime, so results are always identical.
+     * \param p_date_time std::string_view.
+     * \return std::expected< DateTimeFields, Error >
+     */
+    [[nodiscard]] auto parseDateTimeFast(std::string_view p_date_time) noexcept -> std::expected< DateTimeFields, Error >;
+    /**
+     * \overload
+     * \brief Vectorized version of parseDateTime restricted to provided instruction set.
+     * \note If p_instruction_set is not supported by the CPU, widest supported one is used.
+     * \param p_date_time std::string_view.
+     * \param p_instruction_set InstructionSet.
+     * \return std::expected< DateTimeFields, Error >
+     */
+    [[nodiscard]] auto parseDateTimeFast(std::string_view p_date_time, InstructionSet p_instruction_set) noexcept -> std::expected< DateTimeFields, Error >;
+}  // namespace mt::parser
+
+#endif  // PARSER_HPP
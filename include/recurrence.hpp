@@ -0,0 +1,179 @@
+#ifndef RECURRENCE_HPP
+#define RECURRENCE_HPP
+
+#include "date_time.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <utility>
+
+namespace mt::date_time {
+
+    /**
+     * \brief Enum which represents how often recurrence repeats.
+     */
+    enum class Frequency : uint8_t {
+        Daily,
+        Weekly,
+        Monthly,
+        Yearly,
+    };
+
+    /**
+     * \brief Returns bit which represents provided day of the week in RecurrenceRule::week_days mask.
+     * \param p_week_day std::chrono::weekday
+     * \return uint8_t
+     */
+    constexpr auto weekDayBit(const std::chrono::weekday p_week_day) noexcept -> uint8_t { return static_cast< uint8_t >(1U << p_week_day.c_encoding()); }
+
+    /**
+     * \brief RRULE like description of recurrence.
+     * \li Daily - every interval days.
+     * \li Weekly - every interval weeks on days from week_days, or on the day of the week of the start if week_days is empty. Weeks start on Monday.
+     * \li Monthly - every interval months on the day of the month of the start. Day is moved to the last day of shorter months the same way Date
+     * months arithmetic does. If ordinal is not 0 - on ordinal day of the week from week_days instead, counting from the end for negative ordinal.
+     * Months which do not have such day are skipped.
+     * \li Yearly - every interval years on the day of the start, February 29 is moved to February 28 in non leap years.
+     */
+    struct RecurrenceRule {
+        Frequency frequency{Frequency::Daily};
+        uint32_t interval{1};
+        /**
+         * \brief Mask of days of the week built with weekDayBit.
+         */
+        uint8_t week_days{0};
+        /**
+         * \brief For Monthly frequency: 1 to 5 - first to fifth, -1 to -5 - last to fifth from the end day of the week from week_days.
+         */
+        int8_t ordinal{0};
+        /**
+         * \brief Maximal number of occurrences, including the start.
+         */
+        std::optional< uint64_t > count{};
+        /**
+         * \brief Last moment, inclusive, occurrences may fall on.
+         */
+        std::optional< DateTime > until{};
+    };
+
+    /**
+     * \brief Lazy view of recurrence occurrences.
+     * \headerfile recurrence.hpp
+     * Occurrences are computed one by one while the view is iterated, so neither iteration nor after() allocate.
+     * after() jumps directly to the period which contains provided moment instead of walking the series from the start.
+     * For Monthly rules with fifth day of the week the number of preceding occurrences is counted per 400 year calendar cycle,
+     * so at most one cycle of periods is checked.
+     * \note All occurrences have time of the day of the start. If the start is in IANA time zone, occurrences are resolved in that zone the same way
+     * DateTime(date::Date, const time::Time&, ZoneId) does, so their offset follows daylight saving transitions. Otherwise they have offset of the start.
+     * Moments passed to after() and RecurrenceRule::until are compared as instants.
+     */
+    class Recurrence : public std::ranges::view_interface< Recurrence > {
+    public:
+        /**
+         * \brief Input iterator over occurrences.
+         */
+        class Iterator {
+            friend class Recurrence;
+
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = DateTime;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+
+            [[nodiscard]] auto operator*() const -> DateTime;
+            auto operator++() -> Iterator&;
+            auto operator++(int) -> Iterator;
+
+            /**
+             * \brief Returns number of occurrences which precede current one.
+             * \return uint64_t
+             */
+            [[nodiscard]] auto index() const noexcept -> uint64_t { return m_index; }
+
+            friend auto operator==(const Iterator& p_iterator, std::default_sentinel_t) noexcept -> bool { return p_iterator.m_done; }
+
+        private:
+            const Recurrence* m_recurrence{nullptr};
+            int64_t m_period{0};
+            uint64_t m_index{0};
+            int32_t m_day{0};
+            uint8_t m_slot{0};
+            bool m_done{true};
+
+            Iterator(const Recurrence& p_recurrence, int64_t p_period, uint64_t p_index);
+
+            void step() noexcept;
+            void settle();
+        };
+
+        /**
+         * \brief Creates recurrence.
+         * \param p_start const DateTime& first occurrence candidate. For Weekly and Monthly with ordinal start itself is an occurrence only if it matches the rule.
+         * \param p_rule const RecurrenceRule&
+         * \throws std::invalid_argument - if interval is 0, ordinal is out of range, or ordinal is used with frequency other than Monthly
+         * or with week_days mask which does not contain exactly one day.
+         */
+        Recurrence(const DateTime& p_start, const RecurrenceRule& p_rule);
+
+        /**
+         * \brief Returns iterator to the first occurrence.
+         * \return Iterator
+         */
+        [[nodiscard]] auto begin() const -> Iterator;
+        /**
+         * \brief Returns sentinel which is equal to iterator past the last occurrence.
+         * \return std::default_sentinel_t
+         */
+        [[nodiscard]] auto end() const noexcept -> std::default_sentinel_t { return std::default_sentinel; }
+        /**
+         * \brief Returns occurrences which are later than provided moment.
+         * \param p_moment const DateTime&
+         * \return std::ranges::subrange< Iterator, std::default_sentinel_t >
+         */
+        [[nodiscard]] auto after(const DateTime& p_moment) const -> std::ranges::subrange< Iterator, std::default_sentinel_t >;
+
+    private:
+        DateTime m_start;
+        RecurrenceRule m_rule;
+        /**
+         * \brief RecurrenceRule::until as pair of UTC day and nanoseconds since its start.
+         */
+        std::optional< std::pair< int64_t, int64_t > > m_until{};
+        int32_t m_start_day{0};
+        int32_t m_week_start{0};
+        uint8_t m_first_period_count{0};
+        /**
+         * \brief For Monthly rules with ordinal 5 or -5: number of periods after which months repeat and number of occurrences in them.
+         */
+        uint16_t m_cycle_periods{1};
+        uint16_t m_cycle_count{0};
+
+        /**
+         * \brief Returns day of occurrence in provided period, for Weekly - in slot day of the week, or std::nullopt if period does not contain occurrence.
+         */
+        [[nodiscard]] auto candidate(int64_t p_period, uint8_t p_slot) const -> std::optional< int32_t >;
+        /**
+         * \brief Returns number of occurrences in periods which precede provided one.
+         */
+        [[nodiscard]] auto occurrencesBefore(int64_t p_period) const -> uint64_t;
+        /**
+         * \brief Returns number of periods from 1 to p_periods, inclusive, which contain occurrence. Used for Monthly rules only.
+         */
+        [[nodiscard]] auto periodsWithOccurrence(uint64_t p_periods) const -> uint64_t;
+        /**
+         * \brief Returns occurrence on provided day.
+         */
+        [[nodiscard]] auto occurrence(int32_t p_day) const -> DateTime;
+        /**
+         * \brief Returns moment as pair of day and nanoseconds since day start in the zone of the start, or in its offset if it has no zone.
+         */
+        [[nodiscard]] auto localKey(const DateTime& p_moment) const -> std::pair< int64_t, int64_t >;
+    };
+
+}  // namespace mt::date_time
+
+#endif  //RECURRENCE_HPP
@@ -0,0 +1,117 @@
+#ifndef SORT_HPP
+#define SORT_HPP
+
+#include "date_time.hpp"
+#include "executor.hpp"
+#include "packed_date_time.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace mt::batch {
+
+    /**
+     * \brief Returns integer key which orders date times the same way as date followed by time of the day does.
+     * Key is the count of nanoseconds since 1970-01-01T00:00:00 of local date and time, offset is not taken into account.
+     * \param p_date_time const date_time::DateTime&
+     * \return int64_t
+     * \throws std::range_error - if date is out of [1677-09-22, 2262-04-10] range.
+     */
+    [[nodiscard]] auto sortKey(const date_time::DateTime& p_date_time) -> int64_t;
+
+    /**
+     * \brief Sorts keys with least significant digit radix sort.
+     * Keys are processed by 8 bit digits; digits which are the same for all keys, e.g. high bytes of timestamps from one day, are skipped.
+     * \param p_keys std::span< uint64_t >
+     */
+    void radixSort(std::span< uint64_t > p_keys);
+    /**
+     * \overload
+     * \brief Splits histograms and scatter of each pass between threads of p_executor. Result is the same as the single threaded overload produces.
+     * \param p_executor Executor&
+     */
+    void radixSort(Executor& p_executor, std::span< uint64_t > p_keys);
+    /**
+     * \overload
+     */
+    void radixSort(std::span< int64_t > p_keys);
+    /**
+     * \overload
+     */
+    void radixSort(Executor& p_executor, std::span< int64_t > p_keys);
+    /**
+     * \overload
+     * \brief Sorts keys and moves payload together with them. Sort is stable.
+     * \param p_keys std::span< uint64_t >
+     * \param p_values std::span< uint32_t > payload, usually indices of rows.
+     * \throws std::invalid_argument - if sizes of keys and values differ or exceed uint32_t.
+     */
+    void radixSort(std::span< uint64_t > p_keys, std::span< uint32_t > p_values);
+    /**
+     * \overload
+     */
+    void radixSort(Executor& p_executor, std::span< uint64_t > p_keys, std::span< uint32_t > p_values);
+    /**
+     * \overload
+     */
+    void radixSort(std::span< int64_t > p_keys, std::span< uint32_t > p_values);
+    /**
+     * \overload
+     */
+    void radixSort(Executor& p_executor, std::span< int64_t > p_keys, std::span< uint32_t > p_values);
+    /**
+     * \overload
+     */
+    void radixSort(std::span< date_time::PackedDateTime > p_date_times);
+    /**
+     * \overload
+     */
+    void radixSort(Executor& p_executor, std::span< date_time::PackedDateTime > p_date_times);
+    /**
+     * \overload
+     * \brief Sorts date times by sortKey. Sort is stable.
+     * \throws std::range_error - if any date is out of range supported by sortKey.
+     */
+    void radixSort(std::span< date_time::DateTime > p_date_times);
+    /**
+     * \overload
+     */
+    void radixSort(Executor& p_executor, std::span< date_time::DateTime > p_date_times);
+
+    /**
+     * \brief Writes indices which order date times by sortKey, i.e. p_date_times[p_indices[0]] is the earliest one. Sort is stable.
+     * \param p_date_times std::span< const date_time::DateTime >
+     * \param p_indices std::span< uint32_t > should have the size of p_date_times.
+     * \throws std::invalid_argument - if sizes differ or exceed uint32_t.
+     * \throws std::range_error - if any date is out of range supported by sortKey.
+     */
+    void sortedIndices(std::span< const date_time::DateTime > p_date_times, std::span< uint32_t > p_indices);
+    /**
+     * \overload
+     * \brief Sorts keys with threads of p_executor. Result is the same as the single threaded overload produces.
+     * \param p_executor Executor&
+     */
+    void sortedIndices(Executor& p_executor, std::span< const date_time::DateTime > p_date_times, std::span< uint32_t > p_indices);
+
+    /**
+     * \brief Merges two sorted ranges into p_output. Elements of p_first go before equal elements of p_second.
+     * \param p_first std::span< const int64_t >
+     * \param p_second std::span< const int64_t >
+     * \param p_output std::span< int64_t > should have the size of both inputs.
+     * \throws std::invalid_argument - if output size does not match.
+     */
+    void mergeSorted(std::span< const int64_t > p_first, std::span< const int64_t > p_second, std::span< int64_t > p_output);
+    /**
+     * \overload
+     */
+    void mergeSorted(std::span< const uint64_t > p_first, std::span< const uint64_t > p_second, std::span< uint64_t > p_output);
+    /**
+     * \overload
+     */
+    void mergeSorted(std::span< const date_time::PackedDateTime > p_first,
+                     std::span< const date_time::PackedDateTime > p_second,
+                     std::span< date_time::PackedDateTime > p_output);
+
+}  // namespace mt::batch
+
+#endif  //SORT_HPP
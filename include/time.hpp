@@ -2,10 +2,20 @@
 #define TIME_HPP
 
 #include "time_zones.hpp"
+#include "coarse_clock.hpp"
+#include "parser.hpp"
+#include "format_pattern.hpp"
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <chrono>
+#include <expected>
+#include <stdexcept>
 #include <variant>
 #include <functional>
 
@@ -23,6 +33,8 @@ namespace mt::time {
     /**
      * \brief Class to handle time
      * \headerfile time.hpp
+     * \note Arithmetic keeps zone() and utcOffset() of time in IANA time zone, since without date the offset can not be resolved again.
+     * DateTime arithmetic resolves it.
      */
     class Time {
 
@@ -33,6 +45,10 @@ namespace mt::time {
         friend struct std::formatter< Time >;
 
     public:
+        /**
+         * \brief Maximal length of ISO standard representation.
+         */
+        static constexpr std::size_t max_string_length{iso_time_pattern.maxLength()};
         /**
          * \brief Default constructor.
          * Creates time based on UTC time zone
@@ -86,6 +102,41 @@ namespace mt::time {
          * \throws std::invali_argument, std::range_error.
          */
         explicit Time(const std::string& time);
+        /**
+         * \overload
+         * \brief Overloaded constructor.
+         * \param p_since_day_start std::chrono::nanoseconds passed since day start.
+         * \param p_offset TimeZone.
+         * \throws std::range_error - if p_since_day_start is negative or exceeds one day.
+         */
+        constexpr explicit Time(const std::chrono::nanoseconds p_since_day_start, const TimeZone p_offset) :
+            m_nanoseconds_since_day_start(p_since_day_start),
+            m_offset(p_offset) {
+            if (m_nanoseconds_since_day_start < std::chrono::nanoseconds{0} || m_nanoseconds_since_day_start >= std::chrono::days{1}) {
+                throw std::range_error("Bad [since_day_start] value was provided");
+            }
+        }
+        /**
+         * \overload
+         * \brief Creates time in IANA time zone.
+         * \param p_since_day_start std::chrono::nanoseconds passed since local day start.
+         * \param p_utc_offset std::chrono::seconds offset from UTC in effect in p_zone, utcOffset() keeps it exactly,
+         * offset() keeps its whole hours part clamped to TimeZone range, see toTimeZone().
+         * \param p_zone ZoneId
+         * \throws std::range_error - if p_since_day_start is negative or exceeds one day.
+         */
+        constexpr explicit Time(const std::chrono::nanoseconds p_since_day_start, const std::chrono::seconds p_utc_offset, const ZoneId p_zone) :
+            Time(p_since_day_start, toTimeZone(p_utc_offset)) {
+            m_zone = p_zone;
+            m_utc_offset = static_cast< int32_t >(p_utc_offset.count());
+        }
+        /**
+         * \brief Parses std::string_view representing time in formats accepted by string constructor.
+         * Unlike string constructor neither allocates nor throws. [+(-)HH:00] and [Z] offsets are accepted as well.
+         * \param p_time std::string_view.
+         * \return std::expected< Time, mt::parser::Error >.
+         */
+        [[nodiscard]] static auto tryParse(std::string_view p_time) noexcept -> std::expected< Time, mt::parser::Error >;
 
         /**
          * \brief Copy constructor
@@ -111,14 +162,14 @@ namespace mt::time {
          * \return bool
          * \note Precision is taken into account. That is if comparable objects are having different precision - false is returned
          */
-        auto operator==(const Time& other) const -> bool;
+        constexpr auto operator==(const Time& other) const -> bool { return m_nanoseconds_since_day_start == other.m_nanoseconds_since_day_start; }
         /**
          * \brief Operator <
          * \param other const Time&
          * \return bool
          * \note Precision is taken into account. That is if comparable objects are having different precision - false is returned.
          */
-        auto operator<(const Time& other) const -> bool;
+        constexpr auto operator<(const Time& other) const -> bool { return m_nanoseconds_since_day_start < other.m_nanoseconds_since_day_start; }
         /**
          * \brief Operator +=
          * \param other const Time&
@@ -146,6 +197,7 @@ namespace mt::time {
 
         /**
          * \brief Sets timezone offset. Only ISO hour based offsets are considered.
+         * \note Time zone set by IANA zone constructor is dropped.
          * \param p_offset TimeZone
          */
         [[maybe_unused]] void setOffset(TimeZone p_offset);
@@ -179,6 +231,11 @@ namespace mt::time {
          * \return std::chrono::nanoseconds
          */
         [[nodiscard]] auto nanoseconds() const -> std::chrono::nanoseconds;
+        /**
+         * \brief Returns number of nanoseconds passed since day start.
+         * \return std::chrono::nanoseconds
+         */
+        [[nodiscard]] constexpr auto sinceDayStart() const -> std::chrono::nanoseconds { return m_nanoseconds_since_day_start; }
 
         // /**
         //  * \brief Returns precision of Time object.
@@ -190,27 +247,120 @@ namespace mt::time {
          * \brief Returns current offset
          * \return
          */
-        [[nodiscard]] auto offset() const -> mt::TimeZone { return m_offset; }
+        [[nodiscard]] constexpr auto offset() const -> mt::TimeZone { return m_offset; }
+        /**
+         * \brief Returns exact offset from UTC, which is not limited to whole hours for time in IANA time zone.
+         * \return std::chrono::seconds
+         */
+        [[nodiscard]] constexpr auto utcOffset() const -> std::chrono::seconds {
+            if (m_zone == ZoneId::None) {
+                return std::chrono::hours{static_cast< int8_t >(m_offset)};
+            }
+            return std::chrono::seconds{m_utc_offset};
+        }
+        /**
+         * \brief Returns IANA time zone of time.
+         * \return ZoneId, ZoneId::None if only fixed offset is known.
+         */
+        [[nodiscard]] constexpr auto zone() const -> ZoneId { return m_zone; }
 
         /**
          * \brief Creates Time object which represents localtime.
          * \return Time.
          */
         [[nodiscard]] static auto localTime() -> Time;
+        /**
+         * \brief Creates Time object which represents current time in provided time zone.
+         * \param p_clock ClockSource, ClockSource::Coarse reads CoarseClock instead of system clock.
+         * \param p_time_zone TimeZone
+         * \return Time.
+         */
+        [[nodiscard]] static auto now(ClockSource p_clock = ClockSource::System, TimeZone p_time_zone = TimeZone::UTC) noexcept -> Time;
 
         /**
-         * \brief Generates string representation of time which is ISO standard representation in format represented below. Or by formatter provided.
+         * \brief Generates string representation of time which is ISO standard representation in format represented below.
          * \return std::string.
          * \par Default format:
-         * \li [hours:minutes:seconds.milliseconds.microseconds.nanoseconds].
+         * \li [hours:minutes:seconds.nanoseconds+(-)HH:00] or [hours:minutes:seconds.nanosecondsZ] for UTC.
          */
-        [[nodiscard]] auto toString(const std::function< std::string(const Time&) >& formatter = {}) const -> std::string;
+        [[nodiscard]] auto toString() const -> std::string;
+        /**
+         * \overload
+         * \brief Generates string representation of time using provided pattern.
+         * \param p_pattern const FormatPattern&.
+         * \return std::string.
+         * \throws std::invalid_argument - if pattern contains date specifiers.
+         */
+        [[nodiscard]] auto toString(const FormatPattern& p_pattern) const -> std::string;
+        /**
+         * \overload
+         * \brief Generates string representation of time using provided formatter.
+         * If formatter is empty, default format is used.
+         * \return std::string.
+         */
+        [[deprecated("FormatPattern should be used instead")]] [[nodiscard]] auto toString(const std::function< std::string(const Time&) >& formatter) const
+            -> std::string;
+        /**
+         * \brief Writes ISO standard representation into [p_first, p_last) range without allocations.
+         * \param p_first char*
+         * \param p_last char*
+         * \return std::to_chars_result with pointer past the last written character, or std::errc::value_too_large if range is too small.
+         */
+        [[nodiscard]] auto toChars(char* p_first, char* p_last) const noexcept -> std::to_chars_result;
+        /**
+         * \overload
+         * \brief Writes representation built with provided pattern into [p_first, p_last) range without allocations.
+         * \param p_first char*
+         * \param p_last char*
+         * \param p_pattern const FormatPattern&
+         * \return std::to_chars_result with pointer past the last written character, std::errc::value_too_large if range is too small
+         * or std::errc::invalid_argument if pattern is not applicable.
+         */
+        [[nodiscard]] auto toChars(char* p_first, char* p_last, const FormatPattern& p_pattern) const noexcept -> std::to_chars_result;
+        /**
+         * \brief Writes ISO standard representation into output iterator without allocations.
+         * \tparam OutputIt output iterator type
+         * \param p_out OutputIt
+         * \return OutputIt past the last written character.
+         */
+        template < std::output_iterator< char > OutputIt >
+        auto formatTo(OutputIt p_out) const -> OutputIt;
+        /**
+         * \overload
+         * \brief Writes representation built with provided pattern into output iterator without allocations.
+         * \tparam OutputIt output iterator type
+         * \param p_out OutputIt
+         * \param p_pattern const FormatPattern&
+         * \return OutputIt past the last written character.
+         * \throws std::invalid_argument - if pattern is not applicable.
+         */
+        template < std::output_iterator< char > OutputIt >
+        auto formatTo(OutputIt p_out, const FormatPattern& p_pattern) const -> OutputIt;
 
     private:
         std::chrono::nanoseconds m_nanoseconds_since_day_start{};
         TimeZone m_offset{TimeZone::UTC};
+        ZoneId m_zone{ZoneId::None};
+        int32_t m_utc_offset{0};
     };
 
+    template < std::output_iterator< char > OutputIt >
+    auto Time::formatTo(OutputIt p_out) const -> OutputIt {
+        std::array< char, max_string_length > buffer;
+        const auto [end, error] = toChars(buffer.data(), buffer.data() + buffer.size());
+        return std::copy(buffer.data(), end, p_out);
+    }
+
+    template < std::output_iterator< char > OutputIt >
+    auto Time::formatTo(OutputIt p_out, const FormatPattern& p_pattern) const -> OutputIt {
+        std::array< char, FormatPattern::max_formatted_length > buffer;
+        const auto [end, error] = toChars(buffer.data(), buffer.data() + buffer.size(), p_pattern);
+        if (error == std::errc::invalid_argument) {
+            throw std::invalid_argument("Format pattern with date specifiers can not be applied to Time");
+        }
+        return std::copy(buffer.data(), end, p_out);
+    }
+
     /**
      * \brief Operator !=
      * \param l const Time&
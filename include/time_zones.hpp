@@ -1,6 +1,8 @@
 #ifndef TIME_ZONES_HPP
 #define TIME_ZONES_HPP
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 
 namespace mt {
@@ -36,6 +38,39 @@ namespace mt {
         EAST_12 [[maybe_unused]] = 12,
     };
 
+    /**
+     * \brief Handle of IANA time zone loaded by ZoneDatabase.
+     * \note ZoneId::None means that only fixed TimeZone offset is known.
+     */
+    enum class ZoneId : uint16_t {
+        None = 0,
+    };
+
+    /**
+     * \brief Returns whole hours part of UTC offset as TimeZone.
+     * Offsets beyond TimeZone range, e.g. +14:00 of Pacific/Kiritimati, are clamped to WEST_12 and EAST_12.
+     * \param p_utc_offset std::chrono::seconds
+     * \return TimeZone
+     */
+    [[nodiscard]] constexpr auto toTimeZone(const std::chrono::seconds p_utc_offset) noexcept -> TimeZone {
+        return static_cast< TimeZone >(std::clamp< int64_t >(p_utc_offset.count() / 3600, static_cast< int8_t >(TimeZone::WEST_12), static_cast< int8_t >(TimeZone::EAST_12)));
+    }
+
+    /**
+     * \brief Returns offset of local time zone.
+     * Offset is resolved once and cached together with the moment it stays valid until, which is the next daylight saving transition
+     * or one day ahead if there is no transition within a day. Cache is refreshed lazily when that moment is passed.
+     * \note Reading cached offset is lock free, so the function may be called from many threads concurrently.
+     * Changes of TZ environment variable are picked up only on refresh, see refreshLocalOffset().
+     * \return TimeZone
+     */
+    [[nodiscard]] auto localOffset() noexcept -> TimeZone;
+
+    /**
+     * \brief Drops cached local offset, so the next localOffset() call resolves it again.
+     */
+    void refreshLocalOffset() noexcept;
+
 }  // namespace mt
 
 #endif  //TIME_ZONES_HPP
@@ -0,0 +1,70 @@
+#ifndef TIMESTAMP_CACHE_HPP
+#define TIMESTAMP_CACHE_HPP
+
+#include "date_time.hpp"
+#include "time_zones.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+namespace mt::date_time {
+
+    /**
+     * \brief Class which renders ISO standard representation of DateTime and reuses it while consecutive calls fall into the same second.
+     * \headerfile timestamp_cache.hpp
+     * Only fraction digits are rewritten for the call within cached second, so formatting cost is paid once per second.
+     * \note Object is not thread safe. Use TimestampCache::local() to obtain the instance owned by the calling thread.
+     */
+    class TimestampCache {
+    public:
+        /**
+         * \brief Constructor.
+         * \param p_time_zone TimeZone used by now().
+         */
+        explicit TimestampCache(TimeZone p_time_zone = TimeZone::UTC) noexcept;
+
+        /**
+         * \brief Returns representation of provided date time, same as DateTime::toString produces.
+         * \param p_date_time const DateTime&
+         * \return std::string_view valid until the next call on this object.
+         */
+        [[nodiscard]] auto format(const DateTime& p_date_time) noexcept -> std::string_view;
+
+        /**
+         * \brief Returns representation of current date time in the time zone provided on construction.
+         * \return std::string_view valid until the next call on this object.
+         */
+        [[nodiscard]] auto now() noexcept -> std::string_view;
+
+        /**
+         * \brief Returns time zone used by now().
+         * \return TimeZone
+         */
+        [[nodiscard]] auto timeZone() const noexcept -> TimeZone { return m_time_zone; }
+
+        /**
+         * \brief Returns cache owned by the calling thread which formats current time in local time zone.
+         * \note Local offset is read again each time the cached second is left, so the cache follows daylight saving transitions.
+         * \return TimestampCache&
+         */
+        [[nodiscard]] static auto local() -> TimestampCache&;
+
+    private:
+        std::array< char, DateTime::max_string_length > m_buffer{};
+        std::size_t m_length{0};
+        std::size_t m_fraction_position{0};
+        std::chrono::year_month_day m_date{};
+        std::chrono::seconds m_seconds{-1};
+        std::chrono::seconds m_offset{0};
+        TimeZone m_time_zone;
+        bool m_follows_local{false};
+
+        auto render(std::chrono::year_month_day p_date, std::chrono::nanoseconds p_since_day_start, std::chrono::seconds p_offset) noexcept -> std::string_view;
+        auto patch(std::chrono::nanoseconds p_since_day_start) noexcept -> std::string_view;
+    };
+
+}  // namespace mt::date_time
+
+#endif  //TIMESTAMP_CACHE_HPP
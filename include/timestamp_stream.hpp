@@ -0,0 +1,119 @@
+#ifndef TIMESTAMP_STREAM_HPP
+#define TIMESTAMP_STREAM_HPP
+
+#include "date_time.hpp"
+#include "time_zones.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace mt::batch {
+
+    /**
+     * \brief Compressed sequence of instants stored as nanoseconds since 1970-01-01T00:00:00Z.
+     * \headerfile timestamp_stream.hpp
+     * Values are split into blocks of block_rows rows. Block header keeps the first value and position of the block bits,
+     * the rest of the values are stored as zigzag encoded delta of delta with variable length prefix code:
+     * \li [0] - delta of delta is 0, so regularly spaced values take one bit each.
+     * \li [10] + 8 bits, [110] + 16 bits, [1110] + 32 bits, [1111] + 64 bits - otherwise.
+     * Decoding unpacks delta of deltas and restores values with two prefix sums, which run on AVX2 if CPU supports it.
+     * Runs of zero delta of deltas are unpacked a word at a time.
+     * \note Offsets and zones of appended DateTime values are not stored.
+     */
+    class TimestampStream {
+    public:
+        /**
+         * \brief Number of rows in one block. Random access decodes at most this number of rows.
+         */
+        static constexpr std::size_t block_rows{1024};
+
+        /**
+         * \brief Default constructor. Creates empty stream.
+         */
+        TimestampStream() = default;
+        /**
+         * \overload
+         * \brief Creates stream from values.
+         * \param p_epoch_nanoseconds std::span< const int64_t >
+         */
+        explicit TimestampStream(std::span< const int64_t > p_epoch_nanoseconds);
+
+        /**
+         * \brief Appends value to the end of the stream.
+         * \param p_epoch_nanoseconds int64_t nanoseconds since 1970-01-01T00:00:00Z.
+         */
+        void append(int64_t p_epoch_nanoseconds);
+        /**
+         * \overload
+         * \brief Appends instant represented by DateTime.
+         * \param p_date_time const date_time::DateTime&
+         * \throws std::range_error - if instant does not fit std::chrono::nanoseconds.
+         */
+        void append(const date_time::DateTime& p_date_time);
+        /**
+         * \brief Removes all values.
+         */
+        void clear() noexcept;
+
+        /**
+         * \brief Returns number of values.
+         * \return std::size_t
+         */
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+        /**
+         * \brief Returns true if stream has no values.
+         * \return bool
+         */
+        [[nodiscard]] auto empty() const noexcept -> bool { return m_size == 0; }
+        /**
+         * \brief Returns number of bytes encoded values and block headers take.
+         * \return std::size_t
+         */
+        [[nodiscard]] auto bytes() const noexcept -> std::size_t;
+
+        /**
+         * \brief Returns value at p_row. Only the block which holds the row is decoded.
+         * \param p_row std::size_t
+         * \return int64_t
+         * \throws std::out_of_range - if p_row is not less than size().
+         */
+        [[nodiscard]] auto at(std::size_t p_row) const -> int64_t;
+
+        /**
+         * \brief Decodes p_output.size() values starting at p_first row.
+         * \param p_first std::size_t
+         * \param p_output std::span< int64_t >
+         * \throws std::out_of_range - if rows [p_first, p_first + p_output.size()) are not in the stream.
+         */
+        void decode(std::size_t p_first, std::span< int64_t > p_output) const;
+        /**
+         * \overload
+         * \brief Decodes values as date times with p_time_zone offset.
+         * \param p_first std::size_t
+         * \param p_output std::span< date_time::DateTime >
+         * \param p_time_zone TimeZone
+         */
+        void decode(std::size_t p_first, std::span< date_time::DateTime > p_output, TimeZone p_time_zone = TimeZone::UTC) const;
+
+    private:
+        struct Block {
+            int64_t first;
+            std::size_t bit_offset;
+        };
+
+        std::vector< Block > m_blocks;
+        std::vector< uint64_t > m_bits;
+        std::size_t m_bit_size{0};
+        std::size_t m_size{0};
+        int64_t m_last{0};
+        int64_t m_last_delta{0};
+
+        void write(uint64_t p_value, std::size_t p_width);
+        void decodeBlock(std::size_t p_block, std::size_t p_rows, int64_t* p_output) const noexcept;
+        void checkRows(std::size_t p_first, std::size_t p_count) const;
+    };
+
+}  // namespace mt::batch
+
+#endif  //TIMESTAMP_STREAM_HPP
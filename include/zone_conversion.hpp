@@ -0,0 +1,55 @@
+#ifndef ZONE_CONVERSION_HPP
+#define ZONE_CONVERSION_HPP
+
+#include "date_time.hpp"
+#include "executor.hpp"
+#include "zone_database.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace mt::batch {
+
+    /**
+     * \brief Converts UTC instants into date times in IANA time zone.
+     * Offset interval of the last converted instant is kept, so sorted or nearly sorted instants are converted without transition table searches.
+     * \param p_epoch_nanoseconds std::span< const int64_t > nanoseconds since 1970-01-01T00:00:00Z.
+     * \param p_zone ZoneId
+     * \param p_output std::span< date_time::DateTime > should have the size of p_epoch_nanoseconds.
+     * \throws std::invalid_argument - if output size does not match.
+     * \throws std::out_of_range - if p_zone was not returned by ZoneDatabase::locate().
+     */
+    void toLocal(std::span< const int64_t > p_epoch_nanoseconds, ZoneId p_zone, std::span< date_time::DateTime > p_output);
+    /**
+     * \overload
+     * \brief Converts rows in chunks run by p_executor, each chunk keeps its own offset interval.
+     * \param p_executor Executor&
+     */
+    void toLocal(Executor& p_executor, std::span< const int64_t > p_epoch_nanoseconds, ZoneId p_zone, std::span< date_time::DateTime > p_output);
+
+    /**
+     * \brief Converts local date times in IANA time zone into UTC instants, the same way DateTime zone constructor does.
+     * Local interval in which the resolved offset is unambiguous is kept, so sorted or nearly sorted date times are converted without transition table searches.
+     * \note Offsets of input date times are ignored. Result is unspecified if it does not fit int64_t.
+     * \param p_local std::span< const date_time::DateTime >
+     * \param p_zone ZoneId
+     * \param p_epoch_nanoseconds std::span< int64_t > should have the size of p_local.
+     * \param p_choose Choose, which instant local time which happens twice represents.
+     * \throws std::invalid_argument - if output size does not match.
+     * \throws std::out_of_range - if p_zone was not returned by ZoneDatabase::locate().
+     */
+    void toUtc(std::span< const date_time::DateTime > p_local, ZoneId p_zone, std::span< int64_t > p_epoch_nanoseconds, Choose p_choose = Choose::Earliest);
+    /**
+     * \overload
+     * \brief Converts rows in chunks run by p_executor, each chunk keeps its own local interval.
+     * \param p_executor Executor&
+     */
+    void toUtc(Executor& p_executor,
+               std::span< const date_time::DateTime > p_local,
+               ZoneId p_zone,
+               std::span< int64_t > p_epoch_nanoseconds,
+               Choose p_choose = Choose::Earliest);
+
+}  // namespace mt::batch
+
+#endif  //ZONE_CONVERSION_HPP
@@ -0,0 +1,157 @@
+#ifndef ZONE_DATABASE_HPP
+#define ZONE_DATABASE_HPP
+
+#include "time_zones.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace mt {
+
+    /**
+     * \brief Enum which represents how local time which happens twice is resolved.
+     */
+    enum class Choose : uint8_t {
+        Earliest,
+        Latest,
+    };
+
+    /**
+     * \brief IANA time zone backed by memory mapped TZif file.
+     * \headerfile zone_database.hpp
+     * Transition table is read directly from the mapped file and searched in place, nothing is copied or converted when zone is loaded.
+     * Instants after the last transition are resolved with the POSIX TZ rule from the file footer.
+     * \note Only TZif version 2 and later files are supported.
+     */
+    class Zone {
+    public:
+        /**
+         * \brief Maps TZif file.
+         * \param p_name std::string zone name, e.g. Europe/Berlin.
+         * \param p_path const std::filesystem::path&
+         * \throws std::invalid_argument - if file can not be mapped or is not a valid TZif file.
+         */
+        Zone(std::string p_name, const std::filesystem::path& p_path);
+        Zone(const Zone&) = delete;
+        Zone(Zone&&) = delete;
+        auto operator=(const Zone&) -> Zone& = delete;
+        auto operator=(Zone&&) -> Zone& = delete;
+        ~Zone();
+
+        /**
+         * \brief Returns zone name.
+         * \return std::string_view
+         */
+        [[nodiscard]] auto name() const noexcept -> std::string_view { return m_name; }
+        /**
+         * \brief Interval of instants [begin, end) with the same offset from UTC.
+         * \note Unbounded ends are std::numeric_limits< int64_t >::min() and max().
+         */
+        struct Period {
+            int64_t begin;
+            int64_t end;
+            int32_t offset;
+        };
+
+        /**
+         * \brief Returns offset from UTC in effect at provided instant.
+         * \param p_time std::chrono::sys_seconds
+         * \return std::chrono::seconds
+         */
+        [[nodiscard]] auto offset(std::chrono::sys_seconds p_time) const noexcept -> std::chrono::seconds;
+        /**
+         * \brief Returns interval around provided instant in which offset stays the same, so conversions of nearby instants may skip the search.
+         * \param p_time std::chrono::sys_seconds
+         * \return Period, times are seconds since 1970-01-01T00:00:00Z and offset is in seconds.
+         */
+        [[nodiscard]] auto period(std::chrono::sys_seconds p_time) const noexcept -> Period;
+        /**
+         * \brief Returns offset from UTC which local time should be converted with.
+         * \note Local time which is skipped by transition is resolved with the offset in effect before transition, so it is moved forward by the length of the gap.
+         * \param p_time std::chrono::local_seconds
+         * \param p_choose Choose, offset used for local time which happens twice.
+         * \return std::chrono::seconds
+         */
+        [[nodiscard]] auto resolve(std::chrono::local_seconds p_time, Choose p_choose = Choose::Earliest) const noexcept -> std::chrono::seconds;
+
+    private:
+        /**
+         * \brief Day of the year rule of POSIX TZ string: Jn, n or Mm.w.d.
+         */
+        struct RuleDate {
+            char kind{'M'};
+            uint16_t day{0};
+            uint8_t month{0};
+            uint8_t week{0};
+            int32_t time{7200};
+        };
+
+        std::string m_name;
+        const std::byte* m_data{nullptr};
+        std::size_t m_size{0};
+        const std::byte* m_times{nullptr};
+        const std::byte* m_types{nullptr};
+        const std::byte* m_infos{nullptr};
+        std::size_t m_time_count{0};
+        RuleDate m_dst_start{};
+        RuleDate m_dst_end{};
+        int32_t m_std_offset{0};
+        int32_t m_dst_offset{0};
+        bool m_has_rule{false};
+        bool m_has_dst{false};
+
+        void parse();
+        void parseRule(std::string_view p_rule);
+        [[nodiscard]] auto transition(std::size_t p_index) const noexcept -> int64_t;
+        [[nodiscard]] auto typeOffset(std::size_t p_type) const noexcept -> int32_t;
+        [[nodiscard]] auto rulePeriod(int64_t p_time, int64_t p_rule_start) const noexcept -> Period;
+        [[nodiscard]] auto ruleTransition(int32_t p_year, const RuleDate& p_date, int32_t p_offset) const noexcept -> int64_t;
+    };
+
+    /**
+     * \brief Registry of IANA time zones.
+     * \headerfile zone_database.hpp
+     * Zone file is mapped on the first locate() of its name, so nothing is read at startup. Zone lookup by ZoneId is lock free.
+     */
+    class ZoneDatabase {
+    public:
+        /**
+         * \brief Maximal number of zones which may be loaded.
+         */
+        static constexpr std::size_t max_zones{1024};
+
+        /**
+         * \brief Returns handle of zone with provided name, mapping its file on the first call.
+         * \param p_name std::string_view, e.g. America/New_York.
+         * \return ZoneId
+         * \throws std::invalid_argument - if zone does not exist or its file is not valid.
+         * \throws std::length_error - if max_zones zones are already loaded.
+         */
+        [[nodiscard]] static auto locate(std::string_view p_name) -> ZoneId;
+        /**
+         * \brief Returns zone by handle.
+         * \param p_zone ZoneId
+         * \return const Zone&
+         * \throws std::out_of_range - if handle was not returned by locate().
+         */
+        [[nodiscard]] static auto zone(ZoneId p_zone) -> const Zone&;
+        /**
+         * \brief Sets directory zone files are looked up in. TZDIR environment variable or /usr/share/zoneinfo is used by default.
+         * \note Zones which are already loaded are not affected.
+         * \param p_directory std::filesystem::path
+         */
+        static void setDirectory(std::filesystem::path p_directory);
+        /**
+         * \brief Returns directory zone files are looked up in.
+         * \return std::filesystem::path
+         */
+        [[nodiscard]] static auto directory() -> std::filesystem::path;
+    };
+
+}  // namespace mt
+
+#endif  //ZONE_DATABASE_HPP
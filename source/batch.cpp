@@ -0,0 +1,466 @@
+#include "batch.hpp"
+#include "instruction_set.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define MT_BATCH_X86_SIMD
+  #include <immintrin.h>
+#endif
+
+namespace {
+    void checkColumn(std::size_t p_rows, std::size_t p_column_size, const char* p_column);
+    void checkValidity(std::size_t p_rows, std::size_t p_validity_size);
+    auto checkOffsets(std::string_view p_buffer, std::span< const int64_t > p_offsets) -> std::size_t;
+    void checkFormatOutput(std::size_t p_rows, std::size_t p_buffer_size, std::size_t p_offsets_size);
+    void checkColumns(std::size_t p_rows, const mt::batch::DateColumns& p_columns);
+    void checkColumns(std::size_t p_rows, const mt::batch::TimeColumns& p_columns);
+    void checkColumns(std::size_t p_rows, const mt::batch::DateTimeColumns& p_columns);
+    /**
+     * \brief Returns p_count rows of columns from p_first, which should be a multiple of 64.
+     */
+    auto slice(const mt::batch::DateColumns& p_columns, std::size_t p_first, std::size_t p_count) noexcept -> mt::batch::DateColumns;
+    auto slice(const mt::batch::TimeColumns& p_columns, std::size_t p_first, std::size_t p_count) noexcept -> mt::batch::TimeColumns;
+    auto slice(const mt::batch::DateTimeColumns& p_columns, std::size_t p_first, std::size_t p_count) noexcept -> mt::batch::DateTimeColumns;
+
+    /**
+     * \brief Fields of one formatted row.
+     */
+    struct FormatFields {
+        std::chrono::year_month_day date;
+        std::chrono::nanoseconds since_day_start;
+        std::chrono::seconds offset;
+    };
+
+    auto formatScalar(char* p_first, char* p_last, const FormatFields& p_fields) noexcept -> char*;
+#if defined MT_BATCH_X86_SIMD
+    auto formatSSE42(char* p_first, char* p_last, const FormatFields& p_fields) noexcept -> char*;
+#endif
+
+    /**
+     * \brief Formats [p_first, p_last) rows one after another from p_begin and records end of each row, relative to p_begin, in p_offsets.
+     * \param p_row Callable which returns FormatFields of the row.
+     * \return Number of characters written.
+     */
+    template < class Row >
+    auto formatRange(const std::size_t p_first, const std::size_t p_last, Row&& p_row, char* const p_begin, char* const p_end, int64_t* const p_offsets) noexcept
+        -> std::size_t {
+        auto* format = &formatScalar;
+#if defined MT_BATCH_X86_SIMD
+        if (mt::supportedInstructionSet() >= mt::InstructionSet::SSE42) {
+            format = &formatSSE42;
+        }
+#endif
+        char* position = p_begin;
+        for (auto row = p_first; row < p_last; ++row) {
+            position = format(position, p_end, p_row(row));
+            p_offsets[row + 1] = position - p_begin;
+        }
+        return static_cast< std::size_t >(position - p_begin);
+    }
+
+    /**
+     * \brief Formats p_rows rows one after another and records end of each row in p_offsets.
+     * \param p_row Callable which returns FormatFields of the row.
+     * \return Number of characters written.
+     */
+    template < class Row >
+    auto formatRows(const std::size_t p_rows, Row&& p_row, const std::span< char > p_buffer, const std::span< int64_t > p_offsets) -> std::size_t {
+        checkFormatOutput(p_rows, p_buffer.size(), p_offsets.size());
+        p_offsets[0] = 0;
+        return formatRange(0, p_rows, p_row, p_buffer.data(), p_buffer.data() + p_buffer.size(), p_offsets.data());
+    }
+
+    /**
+     * \brief Formats chunks of rows in parallel, each from the position it would take if all rows had the maximal length, then moves chunks together.
+     * \param p_row Callable which returns FormatFields of the row.
+     * \return Number of characters written.
+     */
+    template < class Row >
+    auto formatChunks(mt::batch::Executor& p_executor, const std::size_t p_rows, Row&& p_row, const std::span< char > p_buffer, const std::span< int64_t > p_offsets)
+        -> std::size_t {
+        checkFormatOutput(p_rows, p_buffer.size(), p_offsets.size());
+        constexpr auto chunk_rows = mt::batch::Executor::default_chunk_rows;
+        constexpr auto row_length = mt::date_time::DateTime::max_string_length;
+        std::vector< std::size_t > lengths(p_rows / chunk_rows + 1);
+        p_executor.forEachChunk(
+            p_rows,
+            [&](const std::size_t p_first, const std::size_t p_last) {
+                auto* const begin = p_buffer.data() + p_first * row_length;
+                lengths[p_first / chunk_rows] = formatRange(p_first, p_last, p_row, begin, begin + (p_last - p_first) * row_length, p_offsets.data());
+            },
+            chunk_rows);
+        // Chunks are moved in order and each one ends before the place the next one was formatted at, so no unmoved characters are overwritten.
+        p_offsets[0] = 0;
+        std::size_t position = 0;
+        for (std::size_t first = 0; first < p_rows; first += chunk_rows) {
+            const auto length = lengths[first / chunk_rows];
+            std::memmove(p_buffer.data() + position, p_buffer.data() + first * row_length, length);
+            for (auto row = first; row < std::min(first + chunk_rows, p_rows); ++row) {
+                p_offsets[row + 1] += static_cast< int64_t >(position);
+            }
+            position += length;
+        }
+        return position;
+    }
+
+    /**
+     * \brief Parses chunks of rows in parallel. Chunks hold whole words of validity bitmap.
+     * \param p_parse Callable which parses p_count rows from p_first and returns number of valid ones.
+     * \return Number of valid rows.
+     */
+    template < class Parse >
+    auto parseChunks(mt::batch::Executor& p_executor, const std::size_t p_rows, Parse&& p_parse) -> std::size_t {
+        constexpr auto chunk_rows = mt::batch::Executor::default_chunk_rows;
+        static_assert(chunk_rows % 64 == 0);
+        std::vector< std::size_t > valid_rows(p_rows / chunk_rows + 1);
+        p_executor.forEachChunk(
+            p_rows,
+            [&](const std::size_t p_first, const std::size_t p_last) {
+                valid_rows[p_first / chunk_rows] = p_parse(p_first, p_last - p_first);
+            },
+            chunk_rows);
+        return std::accumulate(valid_rows.begin(), valid_rows.end(), std::size_t{0});
+    }
+
+    /**
+     * \brief Parses p_rows rows and packs validity of each 64 rows into one word.
+     * \param p_row Callable which returns std::string_view of the row.
+     * \param p_parse Callable which parses std::string_view into std::expected.
+     * \param p_store Callable which stores std::expected into output columns.
+     * \return Number of valid rows.
+     */
+    template < class Row, class Parse, class Store >
+    auto parseRows(const std::size_t p_rows, Row&& p_row, Parse&& p_parse, Store&& p_store, const std::span< uint64_t > p_validity) noexcept -> std::size_t {
+        std::size_t valid_rows = 0;
+        for (std::size_t word = 0; word < mt::batch::validityWords(p_rows); ++word) {
+            const auto first = word * 64;
+            const auto last = std::min(first + 64, p_rows);
+            uint64_t bits = 0;
+            for (auto row = first; row < last; ++row) {
+                const auto result = p_parse(p_row(row));
+                p_store(row, result);
+                bits |= static_cast< uint64_t >(result.has_value()) << (row - first);
+            }
+            p_validity[word] = bits;
+            valid_rows += static_cast< std::size_t >(std::popcount(bits));
+        }
+        return valid_rows;
+    }
+
+    auto parseDateRows(const std::size_t p_rows, auto&& p_row, const mt::batch::DateColumns& p_output) -> std::size_t {
+        checkColumns(p_rows, p_output);
+        return parseRows(
+            p_rows,
+            p_row,
+            [](const std::string_view p_date) {
+                return mt::parser::parseDate(p_date);
+            },
+            [&p_output](const std::size_t p_index, const auto& p_result) {
+                p_output.dates[p_index] = p_result ? *p_result : std::chrono::year_month_day{};
+            },
+            p_output.validity);
+    }
+
+    auto parseTimeRows(const std::size_t p_rows, auto&& p_row, const mt::batch::TimeColumns& p_output) -> std::size_t {
+        checkColumns(p_rows, p_output);
+        return parseRows(
+            p_rows,
+            p_row,
+            [](const std::string_view p_time) {
+                return mt::parser::parseTime(p_time);
+            },
+            [&p_output](const std::size_t p_index, const auto& p_result) {
+                const auto fields = p_result ? *p_result : mt::parser::TimeFields{std::chrono::nanoseconds{0}, mt::TimeZone::UTC};
+                p_output.times[p_index] = fields.since_day_start;
+                p_output.offsets[p_index] = fields.offset;
+            },
+            p_output.validity);
+    }
+
+    auto parseDateTimeRows(const std::size_t p_rows, auto&& p_row, const mt::batch::DateTimeColumns& p_output) -> std::size_t {
+        checkColumns(p_rows, p_output);
+        return parseRows(
+            p_rows,
+            p_row,
+            [](const std::string_view p_date_time) {
+                return mt::parser::parseDateTimeFast(p_date_time);
+            },
+            [&p_output](const std::size_t p_index, const auto& p_result) {
+                const auto fields = p_result ? *p_result : mt::parser::DateTimeFields{{}, {std::chrono::nanoseconds{0}, mt::TimeZone::UTC}};
+                p_output.dates[p_index] = fields.date;
+                p_output.times[p_index] = fields.time.since_day_start;
+                p_output.offsets[p_index] = fields.time.offset;
+            },
+            p_output.validity);
+    }
+
+    auto spanRow(const std::span< const std::string_view > p_input) {
+        return [p_input](const std::size_t p_index) {
+            return p_input[p_index];
+        };
+    }
+
+    auto bufferRow(const std::string_view p_buffer, const std::span< const int64_t > p_offsets) {
+        return [p_buffer, p_offsets](const std::size_t p_index) {
+            return p_buffer.substr(static_cast< std::size_t >(p_offsets[p_index]), static_cast< std::size_t >(p_offsets[p_index + 1] - p_offsets[p_index]));
+        };
+    }
+
+    auto dateTimeRow(const std::span< const mt::date_time::DateTime > p_input) {
+        return [p_input](const std::size_t p_index) {
+            const auto& date_time = p_input[p_index];
+            return FormatFields{date_time.date().date(), date_time.time().sinceDayStart(), date_time.time().utcOffset()};
+        };
+    }
+
+    auto epochRow(const std::span< const int64_t > p_epoch_nanoseconds) {
+        return [p_epoch_nanoseconds](const std::size_t p_index) {
+            const std::chrono::sys_time< std::chrono::nanoseconds > time_point{std::chrono::nanoseconds{p_epoch_nanoseconds[p_index]}};
+            const auto days = std::chrono::floor< std::chrono::days >(time_point);
+            return FormatFields{std::chrono::year_month_day{days}, time_point - days, std::chrono::seconds{0}};
+        };
+    }
+}  // End of unnamed namespace
+
+auto mt::batch::parseDates(const std::span< const std::string_view > p_input, const DateColumns& p_output) -> std::size_t {
+    return parseDateRows(p_input.size(), spanRow(p_input), p_output);
+}
+
+auto mt::batch::parseDates(Executor& p_executor, const std::span< const std::string_view > p_input, const DateColumns& p_output) -> std::size_t {
+    checkColumns(p_input.size(), p_output);
+    return parseChunks(p_executor, p_input.size(), [&](const std::size_t p_first, const std::size_t p_count) {
+        return parseDateRows(p_count, spanRow(p_input.subspan(p_first, p_count)), slice(p_output, p_first, p_count));
+    });
+}
+
+auto mt::batch::parseDates(const std::string_view p_buffer, const std::span< const int64_t > p_offsets, const DateColumns& p_output) -> std::size_t {
+    return parseDateRows(checkOffsets(p_buffer, p_offsets), bufferRow(p_buffer, p_offsets), p_output);
+}
+
+auto mt::batch::parseDates(Executor& p_executor, const std::string_view p_buffer, const std::span< const int64_t > p_offsets, const DateColumns& p_output) -> std::size_t {
+    const auto rows = checkOffsets(p_buffer, p_offsets);
+    checkColumns(rows, p_output);
+    return parseChunks(p_executor, rows, [&](const std::size_t p_first, const std::size_t p_count) {
+        return parseDateRows(p_count, bufferRow(p_buffer, p_offsets.subspan(p_first, p_count + 1)), slice(p_output, p_first, p_count));
+    });
+}
+
+auto mt::batch::parseTimes(const std::span< const std::string_view > p_input, const TimeColumns& p_output) -> std::size_t {
+    return parseTimeRows(p_input.size(), spanRow(p_input), p_output);
+}
+
+auto mt::batch::parseTimes(Executor& p_executor, const std::span< const std::string_view > p_input, const TimeColumns& p_output) -> std::size_t {
+    checkColumns(p_input.size(), p_output);
+    return parseChunks(p_executor, p_input.size(), [&](const std::size_t p_first, const std::size_t p_count) {
+        return parseTimeRows(p_count, spanRow(p_input.subspan(p_first, p_count)), slice(p_output, p_first, p_count));
+    });
+}
+
+auto mt::batch::parseTimes(const std::string_view p_buffer, const std::span< const int64_t > p_offsets, const TimeColumns& p_output) -> std::size_t {
+    return parseTimeRows(checkOffsets(p_buffer, p_offsets), bufferRow(p_buffer, p_offsets), p_output);
+}
+
+auto mt::batch::parseTimes(Executor& p_executor, const std::string_view p_buffer, const std::span< const int64_t > p_offsets, const TimeColumns& p_output) -> std::size_t {
+    const auto rows = checkOffsets(p_buffer, p_offsets);
+    checkColumns(rows, p_output);
+    return parseChunks(p_executor, rows, [&](const std::size_t p_first, const std::size_t p_count) {
+        return parseTimeRows(p_count, bufferRow(p_buffer, p_offsets.subspan(p_first, p_count + 1)), slice(p_output, p_first, p_count));
+    });
+}
+
+auto mt::batch::parseDateTimes(const std::span< const std::string_view > p_input, const DateTimeColumns& p_output) -> std::size_t {
+    return parseDateTimeRows(p_input.size(), spanRow(p_input), p_output);
+}
+
+auto mt::batch::parseDateTimes(Executor& p_executor, const std::span< const std::string_view > p_input, const DateTimeColumns& p_output) -> std::size_t {
+    checkColumns(p_input.size(), p_output);
+    return parseChunks(p_executor, p_input.size(), [&](const std::size_t p_first, const std::size_t p_count) {
+        return parseDateTimeRows(p_count, spanRow(p_input.subspan(p_first, p_count)), slice(p_output, p_first, p_count));
+    });
+}
+
+auto mt::batch::parseDateTimes(const std::string_view p_buffer, const std::span< const int64_t > p_offsets, const DateTimeColumns& p_output) -> std::size_t {
+    return parseDateTimeRows(checkOffsets(p_buffer, p_offsets), bufferRow(p_buffer, p_offsets), p_output);
+}
+
+auto mt::batch::parseDateTimes(Executor& p_executor, const std::string_view p_buffer, const std::span< const int64_t > p_offsets, const DateTimeColumns& p_output)
+    -> std::size_t {
+    const auto rows = checkOffsets(p_buffer, p_offsets);
+    checkColumns(rows, p_output);
+    return parseChunks(p_executor, rows, [&](const std::size_t p_first, const std::size_t p_count) {
+        return parseDateTimeRows(p_count, bufferRow(p_buffer, p_offsets.subspan(p_first, p_count + 1)), slice(p_output, p_first, p_count));
+    });
+}
+
+auto mt::batch::formatDateTimes(const std::span< const date_time::DateTime > p_input, const std::span< char > p_buffer, const std::span< int64_t > p_offsets) -> std::size_t {
+    return formatRows(p_input.size(), dateTimeRow(p_input), p_buffer, p_offsets);
+}
+
+auto mt::batch::formatDateTimes(Executor& p_executor,
+                                const std::span< const date_time::DateTime > p_input,
+                                const std::span< char > p_buffer,
+                                const std::span< int64_t > p_offsets) -> std::size_t {
+    return formatChunks(p_executor, p_input.size(), dateTimeRow(p_input), p_buffer, p_offsets);
+}
+
+auto mt::batch::formatDateTimes(const std::span< const int64_t > p_epoch_nanoseconds, const std::span< char > p_buffer, const std::span< int64_t > p_offsets) -> std::size_t {
+    return formatRows(p_epoch_nanoseconds.size(), epochRow(p_epoch_nanoseconds), p_buffer, p_offsets);
+}
+
+auto mt::batch::formatDateTimes(Executor& p_executor,
+                                const std::span< const int64_t > p_epoch_nanoseconds,
+                                const std::span< char > p_buffer,
+                                const std::span< int64_t > p_offsets) -> std::size_t {
+    return formatChunks(p_executor, p_epoch_nanoseconds.size(), epochRow(p_epoch_nanoseconds), p_buffer, p_offsets);
+}
+
+namespace {
+    void checkColumn(const std::size_t p_rows, const std::size_t p_column_size, const char* const p_column) {
+        if (p_column_size != p_rows) {
+            throw std::invalid_argument("mt::batch: [" + std::string{p_column} + "] column has " + std::to_string(p_column_size) + " rows, but " + std::to_string(p_rows)
+                                        + " rows are expected");
+        }
+    }
+
+    void checkValidity(const std::size_t p_rows, const std::size_t p_validity_size) {
+        if (p_validity_size < mt::batch::validityWords(p_rows)) {
+            throw std::invalid_argument("mt::batch: [validity] bitmap has " + std::to_string(p_validity_size) + " words, but "
+                                        + std::to_string(mt::batch::validityWords(p_rows)) + " words are expected");
+        }
+    }
+
+    auto checkOffsets(const std::string_view p_buffer, const std::span< const int64_t > p_offsets) -> std::size_t {
+        if (p_offsets.empty()) {
+            return 0;
+        }
+        int64_t previous = 0;
+        for (const auto offset: p_offsets) {
+            if (offset < previous || static_cast< std::size_t >(offset) > p_buffer.size()) {
+                throw std::invalid_argument("mt::batch: [offsets] should be non decreasing and should not exceed the buffer");
+            }
+            previous = offset;
+        }
+        return p_offsets.size() - 1;
+    }
+
+    void checkFormatOutput(const std::size_t p_rows, const std::size_t p_buffer_size, const std::size_t p_offsets_size) {
+        if (p_buffer_size < mt::batch::formattedDateTimesLength(p_rows)) {
+            throw std::invalid_argument("mt::batch: [buffer] has " + std::to_string(p_buffer_size) + " characters, but "
+                                        + std::to_string(mt::batch::formattedDateTimesLength(p_rows)) + " characters are expected");
+        }
+        if (p_offsets_size < p_rows + 1) {
+            throw std::invalid_argument("mt::batch: [offsets] has " + std::to_string(p_offsets_size) + " rows, but " + std::to_string(p_rows + 1)
+                                        + " rows are expected");
+        }
+    }
+
+    void checkColumns(const std::size_t p_rows, const mt::batch::DateColumns& p_columns) {
+        checkColumn(p_rows, p_columns.dates.size(), "dates");
+        checkValidity(p_rows, p_columns.validity.size());
+    }
+
+    void checkColumns(const std::size_t p_rows, const mt::batch::TimeColumns& p_columns) {
+        checkColumn(p_rows, p_columns.times.size(), "times");
+        checkColumn(p_rows, p_columns.offsets.size(), "offsets");
+        checkValidity(p_rows, p_columns.validity.size());
+    }
+
+    void checkColumns(const std::size_t p_rows, const mt::batch::DateTimeColumns& p_columns) {
+        checkColumn(p_rows, p_columns.dates.size(), "dates");
+        checkColumn(p_rows, p_columns.times.size(), "times");
+        checkColumn(p_rows, p_columns.offsets.size(), "offsets");
+        checkValidity(p_rows, p_columns.validity.size());
+    }
+
+    auto slice(const mt::batch::DateColumns& p_columns, const std::size_t p_first, const std::size_t p_count) noexcept -> mt::batch::DateColumns {
+        return {p_columns.dates.subspan(p_first, p_count), p_columns.validity.subspan(p_first / 64)};
+    }
+
+    auto slice(const mt::batch::TimeColumns& p_columns, const std::size_t p_first, const std::size_t p_count) noexcept -> mt::batch::TimeColumns {
+        return {p_columns.times.subspan(p_first, p_count), p_columns.offsets.subspan(p_first, p_count), p_columns.validity.subspan(p_first / 64)};
+    }
+
+    auto slice(const mt::batch::DateTimeColumns& p_columns, const std::size_t p_first, const std::size_t p_count) noexcept -> mt::batch::DateTimeColumns {
+        return {p_columns.dates.subspan(p_first, p_count),
+                p_columns.times.subspan(p_first, p_count),
+                p_columns.offsets.subspan(p_first, p_count),
+                p_columns.validity.subspan(p_first / 64)};
+    }
+
+    auto formatScalar(char* const p_first, char* const p_last, const FormatFields& p_fields) noexcept -> char* {
+        return mt::iso_date_time_pattern.format(p_first, p_last, p_fields.date, p_fields.since_day_start, p_fields.offset).ptr;
+    }
+
+#if defined MT_BATCH_X86_SIMD
+    /**
+     * \brief Length of YYYY-MM-DDTHH:MM:SS.nnnnnnnnn part of the row.
+     */
+    constexpr std::size_t fixed_length{29};
+
+    /**
+     * \brief Converts value less than 10^8 into 8 digits stored in 16 bit lanes.
+     * \note Division by powers of ten is replaced by multiplication by reciprocals, see W. Mula "SSE: conversion integers to decimal representation".
+     */
+    __attribute__((target("sse4.2"))) inline auto convertDigits(const uint32_t p_value) noexcept -> __m128i {
+        const auto value = _mm_cvtsi32_si128(static_cast< int >(p_value));
+        // abcd, efgh = abcdefgh divmod 10000
+        const auto high = _mm_srli_epi64(_mm_mul_epu32(value, _mm_set1_epi32(static_cast< int >(0xD1B71759))), 45);
+        const auto low = _mm_sub_epi32(value, _mm_mul_epu32(high, _mm_set1_epi32(10000)));
+        // [abcd * 4] x 4, [efgh * 4] x 4
+        const auto quads = _mm_slli_epi64(_mm_unpacklo_epi16(high, low), 2);
+        const auto spread = _mm_unpacklo_epi32(_mm_unpacklo_epi16(quads, quads), _mm_unpacklo_epi16(quads, quads));
+        // [a, ab, abc, abcd, e, ef, efg, efgh]
+        const auto prefixes = _mm_mulhi_epu16(_mm_mulhi_epu16(spread, _mm_setr_epi16(8389, 5243, 13108, -32768, 8389, 5243, 13108, -32768)),
+                                              _mm_setr_epi16(1 << 7, 1 << 11, 1 << 13, -32768, 1 << 7, 1 << 11, 1 << 13, -32768));
+        // [a, b, c, d, e, f, g, h]
+        return _mm_sub_epi16(prefixes, _mm_slli_epi64(_mm_mullo_epi16(prefixes, _mm_set1_epi16(10)), 16));
+    }
+
+    __attribute__((target("sse4.2"))) auto formatSSE42(char* const p_first, char* const p_last, const FormatFields& p_fields) noexcept -> char* {
+        const auto year = static_cast< int32_t >(p_fields.date.year());
+        if (year < 0 || year > 9999) {
+            return formatScalar(p_first, p_last, p_fields);
+        }
+        const auto nanoseconds = static_cast< uint64_t >(p_fields.since_day_start.count());
+        const auto seconds = static_cast< uint32_t >(nanoseconds / 1'000'000'000);
+        const auto fraction = static_cast< uint32_t >(nanoseconds % 1'000'000'000);
+        const auto date = static_cast< uint32_t >(year) * 10000 + static_cast< uint32_t >(p_fields.date.month()) * 100 + static_cast< uint32_t >(p_fields.date.day());
+        const auto time = seconds / 3600 * 1'000'000 + seconds / 60 % 60 * 10'000 + seconds % 60 * 100 + fraction / 10'000'000;
+        const auto zero = _mm_set1_epi8('0');
+        // YYYYMMDDHHMMSSnn and 0nnnnnnn
+        const auto head = _mm_add_epi8(_mm_packus_epi16(convertDigits(date), convertDigits(time)), zero);
+        const auto tail = _mm_add_epi8(_mm_packus_epi16(convertDigits(fraction % 10'000'000), _mm_setzero_si128()), zero);
+        const auto first = _mm_or_si128(_mm_shuffle_epi8(head, _mm_setr_epi8(0, 1, 2, 3, -1, 4, 5, -1, 6, 7, -1, 8, 9, -1, 10, 11)),
+                                        _mm_setr_epi8(0, 0, 0, 0, '-', 0, 0, '-', 0, 0, 'T', 0, 0, ':', 0, 0));
+        const auto second = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(head, _mm_setr_epi8(-1, 12, 13, -1, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+                                                      _mm_shuffle_epi8(tail, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 1, 2, 3, 4, 5, 6, 7, -1, -1, -1))),
+                                         _mm_setr_epi8(':', 0, 0, '.', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+        // Output holds at least max_string_length characters, so both 16 byte stores fit.
+        _mm_storeu_si128(reinterpret_cast< __m128i* >(p_first), first);
+        _mm_storeu_si128(reinterpret_cast< __m128i* >(p_first + 16), second);
+        auto* position = p_first + fixed_length;
+        if (p_fields.offset == std::chrono::seconds{0}) {
+            *position++ = 'Z';
+            return position;
+        }
+        const auto minutes = std::chrono::duration_cast< std::chrono::minutes >(p_fields.offset).count();
+        const auto absolute = static_cast< uint32_t >(minutes < 0 ? -minutes : minutes);
+        const std::array< char, 6 > offset{minutes < 0 ? '-' : '+',
+                                           static_cast< char >('0' + absolute / 600),
+                                           static_cast< char >('0' + absolute / 60 % 10),
+                                           ':',
+                                           static_cast< char >('0' + absolute % 60 / 10),
+                                           static_cast< char >('0' + absolute % 10)};
+        std::memcpy(position, offset.data(), offset.size());
+        return position + offset.size();
+    }
+#endif
+}  // End of unnamed namespace
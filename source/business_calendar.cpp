@@ -0,0 +1,150 @@
+#include "business_calendar.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace {
+    /**
+     * \brief Day of the week of 1970-01-01 in C encoding.
+     */
+    constexpr uint32_t epoch_week_day{std::chrono::Thursday.c_encoding()};
+
+    auto floorDivide(int64_t p_value, int64_t p_divisor) noexcept -> int64_t;
+    auto yearStart(std::chrono::year p_year) noexcept -> int32_t;
+}  // End of unnamed namespace
+
+mt::date::BusinessCalendar::BusinessCalendar(const std::span< const std::chrono::weekday > p_weekend) {
+    for (const auto week_day: p_weekend) {
+        if (not week_day.ok()) {
+            throw std::invalid_argument("mt::date::BusinessCalendar: bad [weekend] value was provided");
+        }
+        m_weekend |= static_cast< uint8_t >(1U << week_day.c_encoding());
+    }
+    // Tables describe the week which starts at 1970-01-01, so day serial modulo 7 is the position in it.
+    for (uint32_t position = 0; position < 7; ++position) {
+        m_week_ranks[position] = m_week_length;
+        if ((m_weekend >> ((epoch_week_day + position) % 7) & 1U) == 0) {
+            m_week_days[static_cast< std::size_t >(m_week_length++)] = static_cast< int32_t >(position);
+        }
+    }
+    m_week_ranks[7] = m_week_length;
+    if (m_week_length == 0) {
+        throw std::invalid_argument("mt::date::BusinessCalendar: all days of the week are weekend days");
+    }
+}
+
+void mt::date::BusinessCalendar::addHoliday(const Date& p_date) { addHolidays(std::span{&p_date, 1}); }
+
+void mt::date::BusinessCalendar::addHolidays(const std::span< const Date > p_dates) {
+    for (const auto& date: p_dates) {
+        m_holidays.push_back(static_cast< int32_t >(date.sinceEpoch().time_since_epoch().count()));
+    }
+    std::ranges::sort(m_holidays);
+    const auto [first, last] = std::ranges::unique(m_holidays);
+    m_holidays.erase(first, last);
+    rebuild();
+}
+
+auto mt::date::BusinessCalendar::isBusinessDay(const Date& p_date) const noexcept -> bool {
+    const auto day = p_date.sinceEpoch().time_since_epoch().count();
+    if (day >= m_begin && day < m_end) {
+        const auto index = static_cast< uint64_t >(day - m_begin);
+        return (m_bits[index / 64] >> (index % 64) & 1U) != 0;
+    }
+    return (m_weekend >> p_date.weekDay().c_encoding() & 1U) == 0;
+}
+
+auto mt::date::BusinessCalendar::addBusinessDays(const Date& p_date, const int64_t p_days) const -> Date {
+    const auto day = p_date.sinceEpoch().time_since_epoch().count();
+    if (p_days == 0) {
+        return p_date;
+    }
+    // Business day which follows p_date has the rank of the day after p_date, the one which precedes it has the rank of p_date minus one.
+    const auto target = p_days > 0 ? rank(day + 1) + p_days - 1 : rank(day) + p_days;
+    return Date{std::chrono::sys_days{std::chrono::days{select(target)}}};
+}
+
+auto mt::date::BusinessCalendar::businessDaysBetween(const Date& p_from, const Date& p_to) const noexcept -> int64_t {
+    return rank(p_to.sinceEpoch().time_since_epoch().count()) - rank(p_from.sinceEpoch().time_since_epoch().count());
+}
+
+void mt::date::BusinessCalendar::rebuild() {
+    m_bits.clear();
+    m_ranks.clear();
+    m_total = 0;
+    if (m_holidays.empty()) {
+        m_begin = m_end = 0;
+        return;
+    }
+    const auto first_year = Date{std::chrono::sys_days{std::chrono::days{m_holidays.front()}}}.year();
+    const auto last_year = Date{std::chrono::sys_days{std::chrono::days{m_holidays.back()}}}.year();
+    m_begin = yearStart(first_year);
+    m_end = yearStart(last_year + std::chrono::years{1});
+
+    const auto length = static_cast< std::size_t >(m_end - m_begin);
+    m_bits.assign((length + 63) / 64, 0);
+    auto position = static_cast< std::size_t >(m_begin - floorDivide(m_begin, 7) * 7);
+    for (std::size_t i = 0; i < length; ++i) {
+        if ((m_weekend >> ((epoch_week_day + position) % 7) & 1U) == 0) {
+            m_bits[i / 64] |= uint64_t{1} << (i % 64);
+        }
+        position = position == 6 ? 0 : position + 1;
+    }
+    for (const auto holiday: m_holidays) {
+        const auto index = static_cast< std::size_t >(holiday - m_begin);
+        m_bits[index / 64] &= ~(uint64_t{1} << (index % 64));
+    }
+    m_ranks.reserve(m_bits.size());
+    for (const auto word: m_bits) {
+        m_ranks.push_back(m_total);
+        m_total += std::popcount(word);
+    }
+}
+
+auto mt::date::BusinessCalendar::weekRank(const int64_t p_day) const noexcept -> int64_t {
+    const auto weeks = floorDivide(p_day, 7);
+    return weeks * m_week_length + m_week_ranks[static_cast< std::size_t >(p_day - weeks * 7)];
+}
+
+auto mt::date::BusinessCalendar::weekSelect(const int64_t p_rank) const noexcept -> int64_t {
+    const auto weeks = floorDivide(p_rank, m_week_length);
+    return weeks * 7 + m_week_days[static_cast< std::size_t >(p_rank - weeks * m_week_length)];
+}
+
+auto mt::date::BusinessCalendar::rank(const int64_t p_day) const noexcept -> int64_t {
+    if (p_day < m_begin) {
+        return weekRank(p_day) - weekRank(m_begin);
+    }
+    if (p_day >= m_end) {
+        return m_total + weekRank(p_day) - weekRank(m_end);
+    }
+    const auto index = static_cast< uint64_t >(p_day - m_begin);
+    const auto preceding = m_bits[index / 64] & ((uint64_t{1} << (index % 64)) - 1);
+    return m_ranks[index / 64] + std::popcount(preceding);
+}
+
+auto mt::date::BusinessCalendar::select(const int64_t p_rank) const noexcept -> int64_t {
+    if (p_rank < 0) {
+        return weekSelect(p_rank + weekRank(m_begin));
+    }
+    if (p_rank >= m_total) {
+        return weekSelect(p_rank - m_total + weekRank(m_end));
+    }
+    const auto word_index = static_cast< std::size_t >(std::ranges::upper_bound(m_ranks, p_rank) - m_ranks.begin() - 1);
+    auto word = m_bits[word_index];
+    for (auto skip = p_rank - m_ranks[word_index]; skip > 0; --skip) {
+        word &= word - 1;
+    }
+    return m_begin + static_cast< int64_t >(word_index * 64) + std::countr_zero(word);
+}
+
+namespace {
+    auto floorDivide(const int64_t p_value, const int64_t p_divisor) noexcept -> int64_t {
+        return p_value / p_divisor - static_cast< int64_t >(p_value % p_divisor < 0);
+    }
+
+    auto yearStart(const std::chrono::year p_year) noexcept -> int32_t {
+        return static_cast< int32_t >(std::chrono::sys_days{p_year / std::chrono::January / 1}.time_since_epoch().count());
+    }
+}  // End of unnamed namespace
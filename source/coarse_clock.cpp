@@ -0,0 +1,73 @@
+#include "coarse_clock.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    /**
+     * \brief Nanoseconds since epoch published by the background thread, zero if the clock is stopped.
+     */
+    std::atomic< int64_t > published{0};
+    std::atomic< int64_t > tick{0};
+    std::mutex control_mutex;
+    std::condition_variable_any stop_requested;
+    std::jthread worker;
+
+    void publish(std::stop_token p_stop_token);
+    auto systemNow() noexcept -> int64_t;
+}  // End of unnamed namespace
+
+auto mt::CoarseClock::now() noexcept -> time_point {
+    const auto value = published.load(std::memory_order_relaxed);
+    if (value == 0) {
+        return time_point{duration{systemNow()}};
+    }
+    return time_point{duration{value}};
+}
+
+void mt::CoarseClock::start(const std::chrono::nanoseconds p_tick) {
+    if (p_tick <= std::chrono::nanoseconds::zero()) {
+        throw std::invalid_argument("mt::CoarseClock: tick should be positive");
+    }
+    std::scoped_lock lock(control_mutex);
+    tick.store(p_tick.count(), std::memory_order_relaxed);
+    if (worker.joinable()) {
+        return;
+    }
+    published.store(systemNow(), std::memory_order_relaxed);
+    worker = std::jthread(publish);
+}
+
+void mt::CoarseClock::stop() {
+    std::scoped_lock lock(control_mutex);
+    if (not worker.joinable()) {
+        return;
+    }
+    worker.request_stop();
+    worker.join();
+    worker = std::jthread{};
+    published.store(0, std::memory_order_relaxed);
+}
+
+auto mt::CoarseClock::isRunning() noexcept -> bool { return published.load(std::memory_order_relaxed) != 0; }
+
+namespace {
+    void publish(const std::stop_token p_stop_token) {
+        std::mutex wait_mutex;
+        std::unique_lock lock(wait_mutex);
+        while (not p_stop_token.stop_requested()) {
+            published.store(systemNow(), std::memory_order_relaxed);
+            // Only stop request interrupts the wait, new tick is picked up on the next iteration.
+            stop_requested.wait_for(lock, p_stop_token, std::chrono::nanoseconds{tick.load(std::memory_order_relaxed)}, [] {
+                return false;
+            });
+        }
+    }
+
+    auto systemNow() noexcept -> int64_t {
+        return std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+}  // End of unnamed namespace
@@ -1,5 +1,6 @@
 #include "date.hpp"
 #include "time.hpp"
+#include "instrumentation.hpp"
 
 #include <algorithm>
 #include <source_location>
@@ -7,21 +8,30 @@
   #include <format>
 #endif
 
-mt::date::Date::Date() { m_date = std::chrono::year_month_day{std::chrono::floor< std::chrono::days >(std::chrono::system_clock::now())}; }
+namespace {
+    auto clampDay(std::chrono::year_month_day p_date) -> std::chrono::year_month_day;
+}  // End of unnamed namespace
+
+mt::date::Date::Date() :
+    Date{std::chrono::floor< std::chrono::days >(std::chrono::system_clock::now())} {
+    mt::instrumentation::count(mt::instrumentation::Counter::ClockReads);
+}
 
 mt::date::Date::Date(const std::chrono::seconds since_epoch) {
     const std::chrono::time_point< std::chrono::system_clock > time_point{std::chrono::duration_cast< std::chrono::system_clock::duration >(since_epoch)};
-    m_date = std::chrono::year_month_day{std::chrono::floor< std::chrono::days >(time_point)};
+    m_days = static_cast< int32_t >(std::chrono::floor< std::chrono::days >(time_point).time_since_epoch().count());
 }
 
 mt::date::Date::Date(mt::TimeZone p_time_zone) {
+    mt::instrumentation::count(mt::instrumentation::Counter::ClockReads);
     auto time_point_now = std::chrono::system_clock::now();
     time_point_now += std::chrono::duration_cast< std::chrono::system_clock::duration >(std::chrono::hours{static_cast< int8_t >(p_time_zone)});
-    m_date = std::chrono::year_month_day{std::chrono::floor< std::chrono::days >(time_point_now)};
+    m_days = static_cast< int32_t >(std::chrono::floor< std::chrono::days >(time_point_now).time_since_epoch().count());
 }
 
 mt::date::Date::Date(const std::chrono::year p_year, const std::chrono::month p_month, const std::chrono::day p_day) {
     if (!p_day.ok()) {
+        mt::instrumentation::count(mt::instrumentation::Counter::DateRangeError);
 #if defined __cpp_lib_format
         throw std::range_error(std::format("Bad [day] value was provided - {} the value between 1 and 31 is expected", p_day));
 #else
@@ -30,6 +40,7 @@ mt::date::Date::Date(const std::chrono::year p_year, const std::chrono::month p_
 #endif
     }
     if (!p_month.ok()) {
+        mt::instrumentation::count(mt::instrumentation::Counter::DateRangeError);
 #if defined __cpp_lib_format
         throw std::range_error(std::format("Bad [month] value was provided - {} the value between 1 and 12 is expected", p_month));
 #else
@@ -38,6 +49,7 @@ mt::date::Date::Date(const std::chrono::year p_year, const std::chrono::month p_
 #endif
     }
     if ((p_month == std::chrono::April || p_month == std::chrono::June || p_month == std::chrono::September || p_month == std::chrono::November) && p_day == std::chrono::day{31}) {
+        mt::instrumentation::count(mt::instrumentation::Counter::DateRangeError);
 #if defined __cpp_lib_format
         throw std::range_error(std::format("Date 31 is not possible for provided month {}", p_month));
 #else
@@ -47,6 +59,7 @@ mt::date::Date::Date(const std::chrono::year p_year, const std::chrono::month p_
     }
     if (p_month == std::chrono::February) {
         if (const auto leap_year = p_year.is_leap(); (leap_year && p_day > std::chrono::day{29}) || (not leap_year && p_day > std::chrono::day{28})) {
+            mt::instrumentation::count(mt::instrumentation::Counter::DateRangeError);
 #if defined __cpp_lib_format
             throw std::range_error(std::format("Day {} is not possible for provided month {}", p_day, p_month));
 #else
@@ -56,7 +69,7 @@ mt::date::Date::Date(const std::chrono::year p_year, const std::chrono::month p_
 #endif
         }
     }
-    m_date = std::chrono::year_month_day{p_year, p_month, p_day};
+    *this = Date{std::chrono::year_month_day{p_year, p_month, p_day}};
 }
 
 mt::date::Date::Date(const std::chrono::years p_years, const std::chrono::months p_months, const std::chrono::days p_days) :
@@ -65,8 +78,11 @@ mt::date::Date::Date(const std::chrono::years p_years, const std::chrono::months
          std::chrono::day{static_cast< uint32_t >(p_days.count())}} { }
 
 mt::date::Date::Date(const std::string& p_iso_date) {
+    mt::instrumentation::count(mt::instrumentation::Counter::DateParses);
+    const mt::instrumentation::CycleTimer timer{mt::instrumentation::Histogram::DateParse};
     const auto l_length = p_iso_date.length();
     if (l_length != 8 && l_length != 10) {
+        mt::instrumentation::countThrow(mt::instrumentation::Counter::DateInvalidArgument, mt::parser::ErrorCode::InvalidLength);
 #if defined __cpp_lib_format
         throw std::invalid_argument(std::format("Provided date has invalid format. Expected either YYYYMMDD either YYYY-MM-DD, but {} received", p_iso_date));
 #else
@@ -100,6 +116,7 @@ mt::date::Date::Date(const std::string& p_iso_date) {
             }
         }
         if (!day.ok()) {
+            mt::instrumentation::countThrow(mt::instrumentation::Counter::DateRangeError, mt::parser::ErrorCode::InvalidDay);
 #if defined __cpp_lib_format
             throw std::range_error(std::format("Bad [day] value was provided - {} the value between 1 and 31 is expected", day));
 #else
@@ -108,6 +125,7 @@ mt::date::Date::Date(const std::string& p_iso_date) {
 #endif
         }
         if (!month.ok()) {
+            mt::instrumentation::countThrow(mt::instrumentation::Counter::DateRangeError, mt::parser::ErrorCode::InvalidMonth);
 #if defined __cpp_lib_format
             throw std::range_error(std::format("Bad [month] value was provided - {} the value between 1 and 12 is expected", month));
 #else
@@ -116,6 +134,7 @@ mt::date::Date::Date(const std::string& p_iso_date) {
 #endif
         }
         if ((month == std::chrono::April || month == std::chrono::June || month == std::chrono::September || month == std::chrono::November) && day == std::chrono::day{31}) {
+            mt::instrumentation::countThrow(mt::instrumentation::Counter::DateRangeError, mt::parser::ErrorCode::InvalidDay);
 #if defined __cpp_lib_format
             throw std::range_error(std::format("Date 31 is not possible for provided month {}", month));
 #else
@@ -125,6 +144,7 @@ mt::date::Date::Date(const std::string& p_iso_date) {
         }
         if (month == std::chrono::February) {
             if (const auto leap_year = year.is_leap(); (leap_year && day > std::chrono::day{29}) || (not leap_year && day > std::chrono::day{28})) {
+                mt::instrumentation::countThrow(mt::instrumentation::Counter::DateRangeError, mt::parser::ErrorCode::InvalidDay);
 #if defined __cpp_lib_format
                 throw std::range_error(std::format("Day {} is not possible for provided month {}", day, month));
 #else
@@ -134,104 +154,92 @@ mt::date::Date::Date(const std::string& p_iso_date) {
 #endif
             }
         }
-        m_date = std::chrono::year_month_day{year, month, day};
+        *this = Date{std::chrono::year_month_day{year, month, day}};
     } else {
+        mt::instrumentation::countThrow(mt::instrumentation::Counter::DateInvalidArgument, mt::parser::ErrorCode::InvalidCharacter);
         throw std::invalid_argument("Bad [iso_date] string format. String should contain only numbers and hyphen");
     }
 }
 
-auto mt::date::Date::operator==(const mt::date::Date& other) const -> bool { return m_date == other.m_date; }
-
-auto mt::date::Date::operator<(const mt::date::Date& other) const -> bool { return m_date < other.m_date; }
+auto mt::date::Date::tryParse(const std::string_view p_iso_date) noexcept -> std::expected< Date, mt::parser::Error > {
+    mt::instrumentation::count(mt::instrumentation::Counter::DateParses);
+    const mt::instrumentation::CycleTimer timer{mt::instrumentation::Histogram::DateParse};
+    const auto date = mt::parser::parseDate(p_iso_date);
+    if (not date) {
+        mt::instrumentation::countFailure(date.error().code);
+        return std::unexpected(date.error());
+    }
+    return Date{*date};
+}
 
 void mt::date::Date::operator+=(const DateDuration p_value) { *this = *this + p_value; }
 
 void mt::date::Date::operator-=(const DateDuration p_value) { *this = *this - p_value; }
 
-auto mt::date::Date::date() const -> std::chrono::year_month_day { return m_date; }
+auto mt::date::Date::monthDay() const -> std::chrono::day { return date().day(); }
 
-auto mt::date::Date::monthDay() const -> std::chrono::day { return m_date.day(); }
+auto mt::date::Date::month() const -> std::chrono::month { return date().month(); }
 
-auto mt::date::Date::weekDay() const -> std::chrono::weekday { return std::chrono::weekday{m_date}; }
+auto mt::date::Date::year() const -> std::chrono::year { return date().year(); }
 
-auto mt::date::Date::month() const -> std::chrono::month { return m_date.month(); }
+auto mt::date::Date::isWeekend() const -> bool {
+    const auto week_day = weekDay();
+    return week_day == std::chrono::Sunday || week_day == std::chrono::Saturday;
+}
 
-auto mt::date::Date::year() const -> std::chrono::year { return m_date.year(); }
+auto mt::date::Date::toString() const -> std::string { return toString(mt::iso_date_pattern); }
 
-auto mt::date::Date::isWeekend() const -> bool { return weekDay() == std::chrono::Sunday || weekDay() == std::chrono::Saturday; }
+auto mt::date::Date::toString(const FormatPattern& p_pattern) const -> std::string {
+    if (p_pattern.usesTime()) {
+        throw std::invalid_argument("Format pattern with time specifiers can not be applied to Date");
+    }
+    mt::instrumentation::count(mt::instrumentation::Counter::StringAllocations);
+    std::string result(p_pattern.maxLength(), '\0');
+    const auto [end, error] = p_pattern.format(result.data(), result.data() + result.size(), date(), std::chrono::nanoseconds{0}, mt::TimeZone::UTC);
+    result.resize(static_cast< std::size_t >(end - result.data()));
+    return result;
+}
 
-std::string mt::date::Date::toString(const std::function< std::string(const Date&) >& formatter) const {
+auto mt::date::Date::toString(const std::function< std::string(const Date&) >& formatter) const -> std::string {
     if (formatter) {
         return formatter(*this);
     }
-#if defined __cpp_lib_format
-    return std::format("{0:%Y-%m-%d}", *this);
-#else
-    std::string result;
-    result += std::to_string(p_date.year< uint16_t >());
-    result += '-';
-    const auto month = p_date.month< uint8_t >();
-    if (month < 10)
-        result += '0';
-    result += std::to_string(month);
-    result += '-';
-    const auto day = p_date.monthDay< uint8_t >();
-    if (day < 10)
-        result += '0';
-    result += std::to_string(day);
+    return toString();
+}
 
-    return result;
-#endif
+auto mt::date::Date::toChars(char* const p_first, char* const p_last) const noexcept -> std::to_chars_result {
+    return mt::iso_date_pattern.format(p_first, p_last, date(), std::chrono::nanoseconds{0}, mt::TimeZone::UTC);
 }
 
-auto mt::date::Date::localDate() -> mt::date::Date {
-    const auto tm = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-    const auto offset = std::localtime(&tm)->tm_gmtoff;
-    return mt::date::Date(static_cast< mt::TimeZone >(offset / 3600));
+auto mt::date::Date::toChars(char* const p_first, char* const p_last, const FormatPattern& p_pattern) const noexcept -> std::to_chars_result {
+    if (p_pattern.usesTime()) {
+        return {p_first, std::errc::invalid_argument};
+    }
+    return p_pattern.format(p_first, p_last, date(), std::chrono::nanoseconds{0}, mt::TimeZone::UTC);
+}
+
+auto mt::date::Date::localDate() -> mt::date::Date { return mt::date::Date(mt::localOffset()); }
+
+auto mt::date::Date::now(const ClockSource p_clock, const TimeZone p_time_zone) noexcept -> Date {
+    const auto time_point = mt::currentTime(p_clock) + std::chrono::hours{static_cast< int8_t >(p_time_zone)};
+    return Date{std::chrono::floor< std::chrono::days >(time_point)};
 }
 
 bool mt::date::operator!=(const mt::date::Date& l, const mt::date::Date& r) { return !(l == r); }
 
-bool mt::date::operator>(const mt::date::Date& l, const mt::date::Date& r) { return !(l < r); }
+bool mt::date::operator>(const mt::date::Date& l, const mt::date::Date& r) { return r < l; }
 
-bool mt::date::operator<=(const mt::date::Date& l, const mt::date::Date& r) { return l < r || l == r; }
+bool mt::date::operator<=(const mt::date::Date& l, const mt::date::Date& r) { return !(r < l); }
 
-bool mt::date::operator>=(const mt::date::Date& l, const mt::date::Date& r) { return l > r || l == r; }
+bool mt::date::operator>=(const mt::date::Date& l, const mt::date::Date& r) { return !(l < r); }
 
 mt::date::Date mt::date::operator+(Date p_date, const DateDuration p_value) {
     std::visit(
         [&p_date]< typename DateValueType >(DateValueType&& value) -> void {
-            if constexpr (std::is_same_v< std::decay_t< DateValueType >, std::chrono::years >) {
-                p_date.m_date += value;
-                if (!p_date.year().is_leap() && p_date.month() == std::chrono::February && p_date.monthDay() == std::chrono::day{29}) {
-                    p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{28}};
-                }
-            } else if constexpr (std::is_same_v< std::decay_t< DateValueType >, std::chrono::months >) {
-                p_date.m_date += value;
-                if (p_date.month() == std::chrono::February && p_date.monthDay() > std::chrono::day{28}) {
-                    if (!p_date.year().is_leap()) {
-                        p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{28}};
-                    } else {
-                        p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{29}};
-                    }
-                } else if (const auto month = p_date.month(); (month == std::chrono::April || month == std::chrono::June || month == std::chrono::September
-                                                              || month == std::chrono::November) && p_date.monthDay() == std::chrono::day{31}) {
-                    p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{30}};
-                }
+            if constexpr (std::is_same_v< std::decay_t< DateValueType >, std::chrono::days >) {
+                p_date += value;
             } else {
-                auto time_point = std::chrono::sys_days(p_date.m_date);
-                time_point += value;
-                p_date.m_date = std::chrono::year_month_day{time_point};
-                if (p_date.month() == std::chrono::February && p_date.monthDay() > std::chrono::day{28}) {
-                    if (!p_date.year().is_leap()) {
-                        p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{28}};
-                    } else {
-                        p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{29}};
-                    }
-                } else if (const auto month = p_date.month(); (month == std::chrono::April || month == std::chrono::June || month == std::chrono::September
-                                                              || month == std::chrono::November) && p_date.monthDay() == std::chrono::day{31}) {
-                    p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{30}};
-                }
+                p_date = Date{clampDay(p_date.date() + value)};
             }
         },
         p_value);
@@ -241,37 +249,10 @@ mt::date::Date mt::date::operator+(Date p_date, const DateDuration p_value) {
 mt::date::Date mt::date::operator-(Date p_date, const DateDuration p_value) {
     std::visit(
         [&p_date]< typename DateValueType >(DateValueType&& value) -> void {
-            if constexpr (std::is_same_v< std::decay_t< DateValueType >, std::chrono::years >) {
-                p_date.m_date -= value;
-                if (!p_date.year().is_leap() && p_date.month() == std::chrono::February && p_date.monthDay() == std::chrono::day{29}) {
-                    p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{28}};
-                }
-            } else if constexpr (std::is_same_v< std::decay_t< DateValueType >, std::chrono::months >) {
-                p_date.m_date -= value;
-                if (p_date.month() == std::chrono::February && p_date.monthDay() > std::chrono::day{28}) {
-                    if (!p_date.year().is_leap()) {
-                        p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{28}};
-                    } else {
-                        p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{29}};
-                    }
-                } else if (const auto month = p_date.month(); (month == std::chrono::April || month == std::chrono::June || month == std::chrono::September
-                                                              || month == std::chrono::November) && p_date.monthDay() == std::chrono::day{31}) {
-                    p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{30}};
-                }
+            if constexpr (std::is_same_v< std::decay_t< DateValueType >, std::chrono::days >) {
+                p_date -= value;
             } else {
-                auto time_point = std::chrono::sys_days(p_date.m_date);
-                time_point -= value;
-                p_date.m_date = std::chrono::year_month_day{time_point};
-                if (p_date.month() == std::chrono::February && p_date.monthDay() > std::chrono::day{28}) {
-                    if (!p_date.year().is_leap()) {
-                        p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{28}};
-                    } else {
-                        p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{29}};
-                    }
-                } else if (const auto month = p_date.month(); (month == std::chrono::April || month == std::chrono::June || month == std::chrono::September
-                                                              || month == std::chrono::November) && p_date.monthDay() == std::chrono::day{31}) {
-                    p_date.m_date = std::chrono::year_month_day{p_date.year(), p_date.month(), std::chrono::day{30}};
-                }
+                p_date = Date{clampDay(p_date.date() - value)};
             }
         },
         p_value);
@@ -279,7 +260,20 @@ mt::date::Date mt::date::operator-(Date p_date, const DateDuration p_value) {
 }
 
 auto mt::date::operator<<(std::ostream& out, const Date& date) -> std::ostream& {
-    const auto& _string = date.toString();
-    out.write(_string.data(), std::ssize(_string));
+    std::array< char, Date::max_string_length > buffer;
+    const auto [end, error] = date.toChars(buffer.data(), buffer.data() + buffer.size());
+    out.write(buffer.data(), end - buffer.data());
     return out;
-}
\ No newline at end of file
+}
+
+namespace {
+    /**
+     * \brief Moves overflowed day of the month, e.g. after adding months to 31st, to the last day of the month.
+     */
+    auto clampDay(const std::chrono::year_month_day p_date) -> std::chrono::year_month_day {
+        if (p_date.ok()) {
+            return p_date;
+        }
+        return std::chrono::year_month_day{p_date.year() / p_date.month() / std::chrono::last};
+    }
+}  // End of unnamed namespace
@@ -0,0 +1,74 @@
+#include "date_range.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+mt::date::DateRange::DateRange(const Date p_first, const Date p_last, const DateDuration p_step) :
+    m_generator{p_first} {
+    std::visit(
+        [this]< typename DateValueType >(DateValueType&& value) -> void {
+            if constexpr (std::is_same_v< std::decay_t< DateValueType >, std::chrono::days >) {
+                m_generator.step = value.count();
+            } else {
+                // Year is exactly 12 months for std::chrono, so both are applied as months.
+                m_generator.step = std::chrono::months{value}.count();
+                m_generator.step_in_months = true;
+            }
+        },
+        p_step);
+    if (m_generator.step == 0) {
+        throw std::invalid_argument("mt::date::DateRange: [step] should not be 0");
+    }
+    int64_t distance{0};
+    if (m_generator.step_in_months) {
+        const auto first = m_generator.first.date();
+        const auto last = p_last.date();
+        distance = (static_cast< int64_t >(static_cast< int32_t >(last.year())) - static_cast< int32_t >(first.year())) * 12 + static_cast< uint32_t >(last.month())
+                 - static_cast< uint32_t >(first.month());
+    } else {
+        distance = (p_last - m_generator.first).count();
+    }
+    // Element which is estimated to be the last may still go past p_last within the same month.
+    auto last_index = distance / m_generator.step;
+    if (last_index >= 0 && (m_generator.step > 0 ? p_last < (*this)[last_index] : (*this)[last_index] < p_last)) {
+        --last_index;
+    }
+    m_size = last_index < 0 ? 0 : last_index + 1;
+}
+
+auto mt::date::DateRange::at(const std::size_t p_index) const -> Date {
+    if (p_index >= size()) {
+        throw std::out_of_range("mt::date::DateRange: index " + std::to_string(p_index) + " is out of range");
+    }
+    return (*this)[static_cast< std::ptrdiff_t >(p_index)];
+}
+
+mt::date_time::DateTimeRange::DateTimeRange(const DateTime& p_first, const DateTime& p_last, const time::TimeDuration p_step) :
+    m_generator{p_first.sinceEpoch().count(), 1, p_first.time().offset(), p_first.time().zone()} {
+    const auto first = m_generator.first;
+    const auto step = std::visit([]< typename TimeValueType >(TimeValueType&& value) -> int64_t { return std::chrono::nanoseconds{value}.count(); }, p_step);
+    m_generator.step = step;
+    if (step == 0) {
+        throw std::invalid_argument("mt::date_time::DateTimeRange: [step] should not be 0");
+    }
+    const auto last = p_last.sinceEpoch().count();
+    if (step > 0 ? last < first : last > first) {
+        return;
+    }
+    // Distance between the ends of nanoseconds range does not fit int64_t, but always fits uint64_t.
+    const auto distance = step > 0 ? static_cast< uint64_t >(last) - static_cast< uint64_t >(first) : static_cast< uint64_t >(first) - static_cast< uint64_t >(last);
+    const auto step_length = step > 0 ? static_cast< uint64_t >(step) : static_cast< uint64_t >(-(step + 1)) + 1;
+    const auto last_index = distance / step_length;
+    if (last_index >= static_cast< uint64_t >(std::numeric_limits< std::ptrdiff_t >::max())) {
+        throw std::length_error("mt::date_time::DateTimeRange: range contains too many elements");
+    }
+    m_size = static_cast< std::ptrdiff_t >(last_index) + 1;
+}
+
+auto mt::date_time::DateTimeRange::at(const std::size_t p_index) const -> DateTime {
+    if (p_index >= size()) {
+        throw std::out_of_range("mt::date_time::DateTimeRange: index " + std::to_string(p_index) + " is out of range");
+    }
+    return (*this)[static_cast< std::ptrdiff_t >(p_index)];
+}
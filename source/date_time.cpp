@@ -1,22 +1,63 @@
 #include "date_time.hpp"
-
-#if defined __cpp_lib_format
-  #include <format>
-#endif
+#include "packed_date_time.hpp"
+#include "instrumentation.hpp"
 
 mt::date_time::DateTime::DateTime(const mt::TimeZone p_time_zone) :
     m_date(p_time_zone),
     m_time(p_time_zone) { }
 
+mt::date_time::DateTime::DateTime(const std::chrono::nanoseconds p_since_epoch, const mt::TimeZone p_time_zone) :
+    DateTime(PackedDateTime{std::chrono::sys_time< std::chrono::nanoseconds >{p_since_epoch}}.toDateTime(p_time_zone)) { }
+
+mt::date_time::DateTime::DateTime(const std::chrono::nanoseconds p_since_epoch, const ZoneId p_zone) {
+    const auto& zone = ZoneDatabase::zone(p_zone);
+    const std::chrono::sys_time< std::chrono::nanoseconds > time_point{p_since_epoch};
+    const auto offset = zone.offset(std::chrono::floor< std::chrono::seconds >(time_point));
+    const auto days = std::chrono::floor< std::chrono::days >(time_point);
+    // Offset is added to time of the day, so the value can not overflow at the ends of the range.
+    auto since_day_start = time_point - days + offset;
+    const auto carry = std::chrono::floor< std::chrono::days >(since_day_start);
+    since_day_start -= carry;
+    m_date = date::Date{days + carry};
+    m_time = time::Time{since_day_start, offset, p_zone};
+}
+
+mt::date_time::DateTime::DateTime(const date::Date p_date, const time::Time& p_time, const ZoneId p_zone, const Choose p_choose) {
+    const auto& zone = ZoneDatabase::zone(p_zone);
+    const auto local = p_date.sinceEpoch().time_since_epoch() + std::chrono::floor< std::chrono::seconds >(p_time.sinceDayStart());
+    const auto offset = zone.resolve(std::chrono::local_seconds{local}, p_choose);
+    // Offset differs from the resolved one only if local time is in the gap, then wall time is moved by the gap length.
+    const auto actual = zone.offset(std::chrono::sys_seconds{local - offset});
+    auto since_day_start = p_time.sinceDayStart() + (actual - offset);
+    const auto carry = std::chrono::floor< std::chrono::days >(since_day_start);
+    since_day_start -= carry;
+    m_date = p_date + carry;
+    m_time = time::Time{since_day_start, actual, p_zone};
+}
+
 mt::date_time::DateTime::DateTime(const std::string& p_date_time) {
+    mt::instrumentation::count(mt::instrumentation::Counter::DateTimeParses);
+    const mt::instrumentation::CycleTimer timer{mt::instrumentation::Histogram::DateTimeParse};
     const auto delimiter_pos = p_date_time.find('T');
     if (delimiter_pos == std::string::npos) {
+        mt::instrumentation::countThrow(mt::instrumentation::Counter::DateTimeRuntimeError, mt::parser::ErrorCode::InvalidCharacter);
         throw std::runtime_error("tristan::date_time::DateTime::DateTime(const std::string& time): Invalid time format");
     }
     m_date = mt::date::Date(p_date_time.substr(0, delimiter_pos));
     m_time = mt::time::Time(p_date_time.substr(delimiter_pos + 1));
 }
 
+auto mt::date_time::DateTime::tryParse(const std::string_view p_date_time) noexcept -> std::expected< DateTime, mt::parser::Error > {
+    mt::instrumentation::count(mt::instrumentation::Counter::DateTimeParses);
+    const mt::instrumentation::CycleTimer timer{mt::instrumentation::Histogram::DateTimeParse};
+    const auto fields = mt::parser::parseDateTimeFast(p_date_time);
+    if (not fields) {
+        mt::instrumentation::countFailure(fields.error().code);
+        return std::unexpected(fields.error());
+    }
+    return DateTime{date::Date{fields->date}, time::Time{fields->time.since_day_start, fields->time.offset}};
+}
+
 void mt::date_time::DateTime::setDate(const mt::date::Date& p_date) { m_date = p_date; }
 
 void mt::date_time::DateTime::setDate(mt::date::Date&& p_date) { m_date = p_date; }
@@ -25,38 +66,45 @@ void mt::date_time::DateTime::setTime(const mt::time::Time& p_time) { m_time = p
 
 void mt::date_time::DateTime::setTime(mt::time::Time&& p_time) { m_time = p_time; }
 
-auto mt::date_time::DateTime::date() const -> const mt::date::Date& { return m_date; }
-
 auto mt::date_time::DateTime::date() -> date::Date& { return m_date; }
 
-auto mt::date_time::DateTime::time() const -> const mt::time::Time& { return m_time; }
-
 auto mt::date_time::DateTime::time() -> time::Time& { return m_time; }
 
+auto mt::date_time::DateTime::toString() const -> std::string { return toString(mt::iso_date_time_pattern); }
+
+auto mt::date_time::DateTime::toString(const FormatPattern& p_pattern) const -> std::string {
+    mt::instrumentation::count(mt::instrumentation::Counter::StringAllocations);
+    std::string result(p_pattern.maxLength(), '\0');
+    const auto [end, error] = p_pattern.format(result.data(), result.data() + result.size(), m_date.date(), m_time.sinceDayStart(), m_time.utcOffset());
+    result.resize(static_cast< std::size_t >(end - result.data()));
+    return result;
+}
+
 auto mt::date_time::DateTime::toString(const std::function< std::string(const DateTime&) >& formatter) const -> std::string {
     if (formatter) {
         return formatter(*this);
     }
+    return toString();
+}
+
+auto mt::date_time::DateTime::toChars(char* const p_first, char* const p_last) const noexcept -> std::to_chars_result {
+    return mt::iso_date_time_pattern.format(p_first, p_last, m_date.date(), m_time.sinceDayStart(), m_time.utcOffset());
+}
 
-#if defined __cpp_lib_format
-    return std::format("{}T{}", m_date.toString(), m_time.toString());
-#else
-    std::string dt;
-    dt += p_date.date().toString();
-    dt += 'T';
-    dt += p_date.time().toString();
-    return dt;
-#endif
+auto mt::date_time::DateTime::toChars(char* const p_first, char* const p_last, const FormatPattern& p_pattern) const noexcept -> std::to_chars_result {
+    return p_pattern.format(p_first, p_last, m_date.date(), m_time.sinceDayStart(), m_time.utcOffset());
 }
 
-auto mt::date_time::DateTime::localDateTime() -> mt::date_time::DateTime {
-    mt::date_time::DateTime l_date_time;
-    l_date_time.setDate(mt::date::Date::localDate());
-    l_date_time.setTime(mt::time::Time::localTime());
+auto mt::date_time::DateTime::localDateTime() -> mt::date_time::DateTime { return now(ClockSource::System, mt::localOffset()); }
 
-    return l_date_time;
+auto mt::date_time::DateTime::now(const ClockSource p_clock, const TimeZone p_time_zone) noexcept -> DateTime {
+    const auto time_point = mt::currentTime(p_clock) + std::chrono::hours{static_cast< int8_t >(p_time_zone)};
+    const auto days = std::chrono::floor< std::chrono::days >(time_point);
+    return DateTime{date::Date{days}, time::Time{time_point - days, p_time_zone}};
 }
 
+auto mt::date_time::DateTime::sinceEpoch() const -> std::chrono::nanoseconds { return PackedDateTime{*this}.sinceEpoch(); }
+
 auto mt::date_time::DateTime::operator==(const mt::date_time::DateTime& other) const -> bool { return m_date == other.m_date && m_time == other.m_time; }
 
 auto mt::date_time::DateTime::operator<(const mt::date_time::DateTime& other) const -> bool {
@@ -88,6 +136,10 @@ auto mt::date_time::operator<=(const mt::date_time::DateTime& l, const mt::date_
 auto mt::date_time::operator>=(const mt::date_time::DateTime& l, const mt::date_time::DateTime& r) -> bool { return l > r || l == r; }
 
 mt::date_time::DateTime mt::date_time::operator+(const DateTime& l, const mt::time::TimeDuration p_time_value) {
+    if (const auto zone = l.time().zone(); zone != ZoneId::None) {
+        // Instant is moved directly and the offset is resolved again, wall clock may cross midnight or a transition.
+        return DateTime{l.sinceEpoch() + std::visit([](auto value) { return std::chrono::nanoseconds{value}; }, p_time_value), zone};
+    }
     std::chrono::days days_to_add{0};
     std::visit(
         [&days_to_add]< typename TimeValueType >(TimeValueType&& value) -> void {
@@ -103,10 +155,16 @@ mt::date_time::DateTime mt::date_time::operator+(const DateTime& l, const mt::ti
 mt::date_time::DateTime mt::date_time::operator+(const DateTime& l, const mt::date::DateDuration p_date_value) {
     DateTime date_time{l};
     date_time.date() += p_date_value;
+    if (const auto zone = l.time().zone(); zone != ZoneId::None) {
+        return DateTime{date_time.date(), date_time.time(), zone};
+    }
     return date_time;
 }
 
 mt::date_time::DateTime mt::date_time::operator-(const DateTime& l, const mt::time::TimeDuration p_time_value) {
+    if (const auto zone = l.time().zone(); zone != ZoneId::None) {
+        return DateTime{l.sinceEpoch() - std::visit([](auto value) { return std::chrono::nanoseconds{value}; }, p_time_value), zone};
+    }
     std::chrono::days days_to_subtract{0};
     std::visit(
         [&days_to_subtract]< typename TimeValueType >(TimeValueType&& value) -> void {
@@ -122,11 +180,15 @@ mt::date_time::DateTime mt::date_time::operator-(const DateTime& l, const mt::ti
 mt::date_time::DateTime mt::date_time::operator-(const DateTime& l, const mt::date::DateDuration p_date_value) {
     DateTime date_time{l};
     date_time.date() -= p_date_value;
+    if (const auto zone = l.time().zone(); zone != ZoneId::None) {
+        return DateTime{date_time.date(), date_time.time(), zone};
+    }
     return date_time;
 }
 
 auto mt::date_time::operator<<(std::ostream& out, const mt::date_time::DateTime& dt) -> std::ostream& {
-    const auto& _string = dt.toString();
-    out.write(_string.data(), std::ssize(_string));
+    std::array< char, DateTime::max_string_length > buffer;
+    const auto [end, error] = dt.toChars(buffer.data(), buffer.data() + buffer.size());
+    out.write(buffer.data(), end - buffer.data());
     return out;
 }
@@ -0,0 +1,173 @@
+#include "date_time_column.hpp"
+#include "epoch.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+  #define MT_KERNEL __attribute__((target_clones("arch=x86-64-v4", "avx2", "default")))
+#else
+  #define MT_KERNEL
+#endif
+
+namespace {
+    /**
+     * \brief Converts days since 1970-01-01 into day of the week, 0 is Sunday.
+     */
+    constexpr auto weekDay(const int32_t p_days) noexcept -> uint32_t { return static_cast< uint32_t >(p_days % 7 + 11) % 7; }
+
+    /**
+     * \brief Converts nanoseconds since day start into seconds since day start.
+     * \note Values are below 2^53, so conversion to double is exact and rounding of the quotient can not cross an integer.
+     */
+    constexpr auto secondOfDay(const int64_t p_since_day_start) noexcept -> uint32_t {
+        return static_cast< uint32_t >(static_cast< double >(p_since_day_start) / 1'000'000'000.0);
+    }
+
+    MT_KERNEL void yearsKernel(const int32_t* p_days, int32_t* p_output, std::size_t p_size) noexcept;
+    MT_KERNEL void monthsKernel(const int32_t* p_days, uint8_t* p_output, std::size_t p_size) noexcept;
+    MT_KERNEL void monthDaysKernel(const int32_t* p_days, uint8_t* p_output, std::size_t p_size) noexcept;
+    MT_KERNEL void weekDaysKernel(const int32_t* p_days, uint8_t* p_output, std::size_t p_size) noexcept;
+    MT_KERNEL void weekendKernel(const int32_t* p_days, bool* p_output, std::size_t p_size) noexcept;
+    MT_KERNEL void hoursKernel(const int64_t* p_since_day_start, uint8_t* p_output, std::size_t p_size) noexcept;
+    MT_KERNEL void minutesKernel(const int64_t* p_since_day_start, uint8_t* p_output, std::size_t p_size) noexcept;
+    MT_KERNEL void secondsKernel(const int64_t* p_since_day_start, uint8_t* p_output, std::size_t p_size) noexcept;
+}  // End of unnamed namespace
+
+mt::batch::DateTimeColumn::DateTimeColumn(const std::span< const date_time::DateTime > p_date_times) {
+    reserve(p_date_times.size());
+    for (const auto& date_time: p_date_times) {
+        append(date_time);
+    }
+}
+
+void mt::batch::DateTimeColumn::append(const date_time::DateTime& p_date_time) {
+    m_days.push_back(static_cast< int32_t >(p_date_time.date().sinceEpoch().time_since_epoch().count()));
+    m_since_day_start.push_back(p_date_time.time().sinceDayStart().count());
+    m_utc_offsets.push_back(static_cast< int32_t >(p_date_time.time().utcOffset().count()));
+    m_zones.push_back(p_date_time.time().zone());
+}
+
+void mt::batch::DateTimeColumn::reserve(const std::size_t p_rows) {
+    m_days.reserve(p_rows);
+    m_since_day_start.reserve(p_rows);
+    m_utc_offsets.reserve(p_rows);
+    m_zones.reserve(p_rows);
+}
+
+void mt::batch::DateTimeColumn::clear() noexcept {
+    m_days.clear();
+    m_since_day_start.clear();
+    m_utc_offsets.clear();
+    m_zones.clear();
+}
+
+auto mt::batch::DateTimeColumn::at(const std::size_t p_row) const -> date_time::DateTime {
+    if (p_row >= size()) {
+        throw std::out_of_range("mt::batch::DateTimeColumn: row " + std::to_string(p_row) + " is out of range");
+    }
+    const std::chrono::nanoseconds since_day_start{m_since_day_start[p_row]};
+    const std::chrono::seconds utc_offset{m_utc_offsets[p_row]};
+    // Offsets of rows without zone are whole hours, so they convert to TimeZone exactly.
+    return date_time::DateTime{date::Date{std::chrono::sys_days{std::chrono::days{m_days[p_row]}}},
+                               m_zones[p_row] == ZoneId::None ? time::Time{since_day_start, toTimeZone(utc_offset)}
+                                                              : time::Time{since_day_start, utc_offset, m_zones[p_row]}};
+}
+
+void mt::batch::DateTimeColumn::years(const std::span< int32_t > p_output) const {
+    checkOutput(p_output.size());
+    yearsKernel(m_days.data(), p_output.data(), size());
+}
+
+void mt::batch::DateTimeColumn::months(const std::span< uint8_t > p_output) const {
+    checkOutput(p_output.size());
+    monthsKernel(m_days.data(), p_output.data(), size());
+}
+
+void mt::batch::DateTimeColumn::monthDays(const std::span< uint8_t > p_output) const {
+    checkOutput(p_output.size());
+    monthDaysKernel(m_days.data(), p_output.data(), size());
+}
+
+void mt::batch::DateTimeColumn::weekDays(const std::span< uint8_t > p_output) const {
+    checkOutput(p_output.size());
+    weekDaysKernel(m_days.data(), p_output.data(), size());
+}
+
+void mt::batch::DateTimeColumn::isWeekend(const std::span< bool > p_output) const {
+    checkOutput(p_output.size());
+    weekendKernel(m_days.data(), p_output.data(), size());
+}
+
+void mt::batch::DateTimeColumn::hours(const std::span< uint8_t > p_output) const {
+    checkOutput(p_output.size());
+    hoursKernel(m_since_day_start.data(), p_output.data(), size());
+}
+
+void mt::batch::DateTimeColumn::minutes(const std::span< uint8_t > p_output) const {
+    checkOutput(p_output.size());
+    minutesKernel(m_since_day_start.data(), p_output.data(), size());
+}
+
+void mt::batch::DateTimeColumn::seconds(const std::span< uint8_t > p_output) const {
+    checkOutput(p_output.size());
+    secondsKernel(m_since_day_start.data(), p_output.data(), size());
+}
+
+void mt::batch::DateTimeColumn::checkOutput(const std::size_t p_output_size) const {
+    if (p_output_size != size()) {
+        throw std::invalid_argument("mt::batch::DateTimeColumn: output has " + std::to_string(p_output_size) + " rows, but " + std::to_string(size())
+                                    + " rows are expected");
+    }
+}
+
+namespace {
+    MT_KERNEL void yearsKernel(const int32_t* const p_days, int32_t* const p_output, const std::size_t p_size) noexcept {
+        for (std::size_t i = 0; i < p_size; ++i) {
+            p_output[i] = mt::batch::civilFromDays(p_days[i]).year;
+        }
+    }
+
+    MT_KERNEL void monthsKernel(const int32_t* const p_days, uint8_t* const p_output, const std::size_t p_size) noexcept {
+        for (std::size_t i = 0; i < p_size; ++i) {
+            p_output[i] = static_cast< uint8_t >(mt::batch::civilFromDays(p_days[i]).month);
+        }
+    }
+
+    MT_KERNEL void monthDaysKernel(const int32_t* const p_days, uint8_t* const p_output, const std::size_t p_size) noexcept {
+        for (std::size_t i = 0; i < p_size; ++i) {
+            p_output[i] = static_cast< uint8_t >(mt::batch::civilFromDays(p_days[i]).day);
+        }
+    }
+
+    MT_KERNEL void weekDaysKernel(const int32_t* const p_days, uint8_t* const p_output, const std::size_t p_size) noexcept {
+        for (std::size_t i = 0; i < p_size; ++i) {
+            p_output[i] = static_cast< uint8_t >(weekDay(p_days[i]));
+        }
+    }
+
+    MT_KERNEL void weekendKernel(const int32_t* const p_days, bool* const p_output, const std::size_t p_size) noexcept {
+        for (std::size_t i = 0; i < p_size; ++i) {
+            const auto week_day = weekDay(p_days[i]);
+            p_output[i] = (week_day == 0) | (week_day == 6);
+        }
+    }
+
+    MT_KERNEL void hoursKernel(const int64_t* const p_since_day_start, uint8_t* const p_output, const std::size_t p_size) noexcept {
+        for (std::size_t i = 0; i < p_size; ++i) {
+            p_output[i] = static_cast< uint8_t >(secondOfDay(p_since_day_start[i]) / 3'600);
+        }
+    }
+
+    MT_KERNEL void minutesKernel(const int64_t* const p_since_day_start, uint8_t* const p_output, const std::size_t p_size) noexcept {
+        for (std::size_t i = 0; i < p_size; ++i) {
+            p_output[i] = static_cast< uint8_t >(secondOfDay(p_since_day_start[i]) / 60 % 60);
+        }
+    }
+
+    MT_KERNEL void secondsKernel(const int64_t* const p_since_day_start, uint8_t* const p_output, const std::size_t p_size) noexcept {
+        for (std::size_t i = 0; i < p_size; ++i) {
+            p_output[i] = static_cast< uint8_t >(secondOfDay(p_since_day_start[i]) % 60);
+        }
+    }
+}  // End of unnamed namespace
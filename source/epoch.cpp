@@ -0,0 +1,123 @@
+#include "epoch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+  #define MT_KERNEL __attribute__((target_clones("arch=x86-64-v4", "avx2", "default")))
+#else
+  #define MT_KERNEL
+#endif
+
+namespace {
+    /**
+     * \brief Number of rows converted through intermediate days buffer at once.
+     */
+    constexpr std::size_t block_size{1'024};
+
+    void checkColumns(std::size_t p_rows, const mt::batch::CivilColumns& p_columns);
+    auto slice(const mt::batch::CivilColumns& p_columns, std::size_t p_first, std::size_t p_count) noexcept -> mt::batch::CivilColumns;
+    MT_KERNEL void splitKernel(const int64_t* p_epoch, int64_t p_ticks_per_day, int32_t* p_days, int64_t* p_since_day_start, std::size_t p_size) noexcept;
+    MT_KERNEL void civilKernel(const int32_t* p_days, int32_t* p_years, uint8_t* p_months, uint8_t* p_month_days, std::size_t p_size) noexcept;
+    MT_KERNEL void epochKernel(const int32_t* p_years,
+                               const uint8_t* p_months,
+                               const uint8_t* p_month_days,
+                               const int64_t* p_since_day_start,
+                               int64_t p_ticks_per_day,
+                               int64_t* p_epoch,
+                               std::size_t p_size) noexcept;
+}  // End of unnamed namespace
+
+void mt::batch::epochToCivil(const std::span< const int64_t > p_epoch, const EpochUnit p_unit, const CivilColumns& p_output) {
+    checkColumns(p_epoch.size(), p_output);
+    // Split needs 64 bit lanes and civil conversion 32 bit ones, so they are separate loops, each of which may be vectorized on its own.
+    std::array< int32_t, block_size > days;
+    for (std::size_t first = 0; first < p_epoch.size(); first += block_size) {
+        const auto size = std::min(block_size, p_epoch.size() - first);
+        splitKernel(p_epoch.data() + first, ticksPerDay(p_unit), days.data(), p_output.since_day_start.data() + first, size);
+        civilKernel(days.data(), p_output.years.data() + first, p_output.months.data() + first, p_output.days.data() + first, size);
+    }
+}
+
+void mt::batch::epochToCivil(Executor& p_executor, const std::span< const int64_t > p_epoch, const EpochUnit p_unit, const CivilColumns& p_output) {
+    checkColumns(p_epoch.size(), p_output);
+    p_executor.forEachChunk(p_epoch.size(), [&](const std::size_t p_first, const std::size_t p_last) {
+        epochToCivil(p_epoch.subspan(p_first, p_last - p_first), p_unit, slice(p_output, p_first, p_last - p_first));
+    });
+}
+
+void mt::batch::civilToEpoch(const CivilColumns& p_input, const EpochUnit p_unit, const std::span< int64_t > p_epoch) {
+    checkColumns(p_epoch.size(), p_input);
+    epochKernel(p_input.years.data(), p_input.months.data(), p_input.days.data(), p_input.since_day_start.data(), ticksPerDay(p_unit), p_epoch.data(), p_epoch.size());
+}
+
+void mt::batch::civilToEpoch(Executor& p_executor, const CivilColumns& p_input, const EpochUnit p_unit, const std::span< int64_t > p_epoch) {
+    checkColumns(p_epoch.size(), p_input);
+    p_executor.forEachChunk(p_epoch.size(), [&](const std::size_t p_first, const std::size_t p_last) {
+        civilToEpoch(slice(p_input, p_first, p_last - p_first), p_unit, p_epoch.subspan(p_first, p_last - p_first));
+    });
+}
+
+namespace {
+    void checkColumns(const std::size_t p_rows, const mt::batch::CivilColumns& p_columns) {
+        for (const auto& [size, column]: {std::pair{p_columns.years.size(), "years"},
+                                          std::pair{p_columns.months.size(), "months"},
+                                          std::pair{p_columns.days.size(), "days"},
+                                          std::pair{p_columns.since_day_start.size(), "since_day_start"}}) {
+            if (size != p_rows) {
+                throw std::invalid_argument("mt::batch: [" + std::string{column} + "] column has " + std::to_string(size) + " rows, but " + std::to_string(p_rows)
+                                            + " rows are expected");
+            }
+        }
+    }
+
+    auto slice(const mt::batch::CivilColumns& p_columns, const std::size_t p_first, const std::size_t p_count) noexcept -> mt::batch::CivilColumns {
+        return {p_columns.years.subspan(p_first, p_count),
+                p_columns.months.subspan(p_first, p_count),
+                p_columns.days.subspan(p_first, p_count),
+                p_columns.since_day_start.subspan(p_first, p_count)};
+    }
+
+    MT_KERNEL void splitKernel(const int64_t* const p_epoch,
+                               const int64_t p_ticks_per_day,
+                               int32_t* const p_days,
+                               int64_t* const p_since_day_start,
+                               const std::size_t p_size) noexcept {
+        const auto reciprocal = 1.0 / static_cast< double >(p_ticks_per_day);
+        for (std::size_t i = 0; i < p_size; ++i) {
+            // Estimate is off by at most one day, which is corrected with exact integer remainder.
+            auto days = static_cast< int64_t >(static_cast< double >(p_epoch[i]) * reciprocal);
+            auto rest = p_epoch[i] - days * p_ticks_per_day;
+            days -= rest < 0;
+            rest += rest < 0 ? p_ticks_per_day : 0;
+            days += rest >= p_ticks_per_day;
+            rest -= rest >= p_ticks_per_day ? p_ticks_per_day : 0;
+            p_days[i] = static_cast< int32_t >(days);
+            p_since_day_start[i] = rest;
+        }
+    }
+
+    MT_KERNEL void civilKernel(const int32_t* const p_days, int32_t* const p_years, uint8_t* const p_months, uint8_t* const p_month_days, const std::size_t p_size) noexcept {
+        for (std::size_t i = 0; i < p_size; ++i) {
+            const auto date = mt::batch::civilFromDays(p_days[i]);
+            p_years[i] = date.year;
+            p_months[i] = static_cast< uint8_t >(date.month);
+            p_month_days[i] = static_cast< uint8_t >(date.day);
+        }
+    }
+
+    MT_KERNEL void epochKernel(const int32_t* const p_years,
+                               const uint8_t* const p_months,
+                               const uint8_t* const p_month_days,
+                               const int64_t* const p_since_day_start,
+                               const int64_t p_ticks_per_day,
+                               int64_t* const p_epoch,
+                               const std::size_t p_size) noexcept {
+        for (std::size_t i = 0; i < p_size; ++i) {
+            const auto days = mt::batch::daysFromCivil({p_years[i], p_months[i], p_month_days[i]});
+            p_epoch[i] = static_cast< int64_t >(days) * p_ticks_per_day + p_since_day_start[i];
+        }
+    }
+}  // End of unnamed namespace
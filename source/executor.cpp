@@ -0,0 +1,187 @@
+#include "executor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    /**
+     * \brief Set while the thread runs chunks, so loops submitted from inside a chunk are not queued behind the loop which waits for them.
+     */
+    thread_local bool inside_loop{false};
+
+    /**
+     * \brief Contiguous run of chunks dealt to one thread. Other threads steal from it through the same counter.
+     */
+    struct alignas(64) Lane {
+        std::atomic< std::size_t > next{0};
+        std::size_t end{0};
+    };
+
+    /**
+     * \brief Loop which is being run.
+     */
+    struct Loop {
+        std::size_t rows{0};
+        std::size_t chunk_rows{1};
+        void (*chunk)(const void*, std::size_t, std::size_t){nullptr};
+        const void* function{nullptr};
+        std::vector< Lane > lanes;
+        std::atomic< bool > failed{false};
+        std::mutex error_mutex;
+        std::exception_ptr error;
+        std::size_t active{0};
+    };
+
+    void runChunk(Loop& p_loop, std::size_t p_chunk) noexcept;
+    /**
+     * \brief Runs chunks of own lane, then steals chunks of the other lanes until all are taken.
+     */
+    void runLane(Loop& p_loop, std::size_t p_lane) noexcept;
+}  // End of unnamed namespace
+
+struct mt::batch::Executor::State {
+    std::size_t threads{1};
+    std::mutex submit_mutex;
+    std::mutex mutex;
+    std::condition_variable loop_started;
+    std::condition_variable loop_finished;
+    Loop* loop{nullptr};
+    uint64_t generation{0};
+    bool stopping{false};
+    std::vector< std::thread > workers;
+
+    void work(std::size_t p_lane);
+};
+
+mt::batch::Executor::Executor(const std::size_t p_threads) :
+    m_state(std::make_unique< State >()) {
+    m_state->threads = p_threads == 0 ? std::max< std::size_t >(std::thread::hardware_concurrency(), 1) : p_threads;
+    m_state->workers.reserve(m_state->threads - 1);
+    for (std::size_t lane = 1; lane < m_state->threads; ++lane) {
+        m_state->workers.emplace_back(&State::work, m_state.get(), lane);
+    }
+}
+
+mt::batch::Executor::~Executor() {
+    {
+        const std::scoped_lock lock{m_state->submit_mutex, m_state->mutex};
+        m_state->stopping = true;
+    }
+    m_state->loop_started.notify_all();
+    for (auto& worker: m_state->workers) {
+        worker.join();
+    }
+}
+
+auto mt::batch::Executor::threads() const noexcept -> std::size_t { return m_state->threads; }
+
+auto mt::batch::Executor::shared() -> Executor& {
+    static Executor executor;
+    return executor;
+}
+
+void mt::batch::Executor::run(const std::size_t p_rows, const std::size_t p_chunk_rows, const Chunk p_chunk, const void* const p_function) {
+    const auto chunk_rows = std::max< std::size_t >(p_chunk_rows, 1);
+    const auto chunks = p_rows / chunk_rows + static_cast< std::size_t >(p_rows % chunk_rows != 0);
+    if (chunks <= 1 || m_state->threads == 1 || inside_loop) {
+        for (std::size_t first = 0; first < p_rows; first += chunk_rows) {
+            p_chunk(p_function, first, std::min(first + chunk_rows, p_rows));
+        }
+        return;
+    }
+    const std::scoped_lock submit_lock{m_state->submit_mutex};
+    Loop loop{};
+    loop.rows = p_rows;
+    loop.chunk_rows = chunk_rows;
+    loop.chunk = p_chunk;
+    loop.function = p_function;
+    loop.lanes = std::vector< Lane >(m_state->threads);
+    for (std::size_t lane = 0; lane < loop.lanes.size(); ++lane) {
+        loop.lanes[lane].next.store(chunks * lane / loop.lanes.size(), std::memory_order_relaxed);
+        loop.lanes[lane].end = chunks * (lane + 1) / loop.lanes.size();
+    }
+    {
+        const std::scoped_lock lock{m_state->mutex};
+        m_state->loop = &loop;
+        ++m_state->generation;
+        ++loop.active;
+    }
+    m_state->loop_started.notify_all();
+    inside_loop = true;
+    runLane(loop, 0);
+    inside_loop = false;
+    {
+        std::unique_lock lock{m_state->mutex};
+        --loop.active;
+        // All chunks are taken once the calling thread leaves its loop, so only the ones still running are waited for.
+        m_state->loop_finished.wait(lock, [&loop] { return loop.active == 0; });
+        m_state->loop = nullptr;
+    }
+    if (loop.error) {
+        std::rethrow_exception(loop.error);
+    }
+}
+
+void mt::batch::Executor::State::work(const std::size_t p_lane) {
+    inside_loop = true;
+    uint64_t seen_generation{0};
+    while (true) {
+        Loop* current{nullptr};
+        {
+            std::unique_lock lock{mutex};
+            loop_started.wait(lock, [this, seen_generation] { return stopping || generation != seen_generation; });
+            if (stopping) {
+                return;
+            }
+            seen_generation = generation;
+            current = loop;
+            if (current == nullptr) {
+                continue;
+            }
+            ++current->active;
+        }
+        runLane(*current, p_lane);
+        bool finished{false};
+        {
+            const std::scoped_lock lock{mutex};
+            finished = --current->active == 0;
+        }
+        if (finished) {
+            loop_finished.notify_all();
+        }
+    }
+}
+
+namespace {
+    void runChunk(Loop& p_loop, const std::size_t p_chunk) noexcept {
+        if (p_loop.failed.load(std::memory_order_relaxed)) {
+            return;
+        }
+        const auto first = p_chunk * p_loop.chunk_rows;
+        try {
+            p_loop.chunk(p_loop.function, first, std::min(first + p_loop.chunk_rows, p_loop.rows));
+        } catch (...) {
+            const std::scoped_lock lock{p_loop.error_mutex};
+            if (not p_loop.error) {
+                p_loop.error = std::current_exception();
+            }
+            p_loop.failed.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    void runLane(Loop& p_loop, const std::size_t p_lane) noexcept {
+        const auto lanes = p_loop.lanes.size();
+        for (std::size_t i = 0; i < lanes; ++i) {
+            auto& lane = p_loop.lanes[(p_lane + i) % lanes];
+            for (auto chunk = lane.next.fetch_add(1, std::memory_order_relaxed); chunk < lane.end; chunk = lane.next.fetch_add(1, std::memory_order_relaxed)) {
+                runChunk(p_loop, chunk);
+            }
+        }
+    }
+}  // End of unnamed namespace
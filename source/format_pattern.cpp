@@ -0,0 +1,128 @@
+#include "format_pattern.hpp"
+
+#include <cstring>
+
+namespace {
+    constexpr std::array< int64_t, 10 > powers_of_ten{1, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000, 1'000'000'000};
+
+    /**
+     * \brief Writes p_value as p_width digits, left padded with zeroes.
+     */
+    inline auto writeDigits(char* p_first, uint64_t p_value, const std::size_t p_width) noexcept -> char* {
+        for (auto* position = p_first + p_width; position != p_first;) {
+            *--position = static_cast< char >('0' + p_value % 10);
+            p_value /= 10;
+        }
+        return p_first + p_width;
+    }
+
+    /**
+     * \brief Writes offset as +(-)HHMM, or as +(-)HH:MM if p_extended is true.
+     */
+    inline auto writeOffset(char* p_first, const std::chrono::seconds p_offset, const bool p_extended) noexcept -> char* {
+        const auto minutes = std::chrono::duration_cast< std::chrono::minutes >(p_offset).count();
+        const auto absolute = static_cast< uint64_t >(minutes < 0 ? -minutes : minutes);
+        *p_first++ = minutes < 0 ? '-' : '+';
+        p_first = writeDigits(p_first, absolute / 60, 2);
+        if (p_extended) {
+            *p_first++ = ':';
+        }
+        return writeDigits(p_first, absolute % 60, 2);
+    }
+}  // End of unnamed namespace
+
+auto mt::FormatPattern::format(char* const p_first,
+                               char* const p_last,
+                               const std::chrono::year_month_day p_date,
+                               const std::chrono::nanoseconds p_since_day_start,
+                               const std::chrono::seconds p_offset) const noexcept -> std::to_chars_result {
+    if (p_last - p_first >= static_cast< std::ptrdiff_t >(m_max_length)) {
+        return {formatUnchecked(p_first, p_date, p_since_day_start, p_offset), std::errc{}};
+    }
+    std::array< char, max_formatted_length > buffer;
+    const auto* const end = formatUnchecked(buffer.data(), p_date, p_since_day_start, p_offset);
+    const auto length = end - buffer.data();
+    if (length > p_last - p_first) {
+        return {p_last, std::errc::value_too_large};
+    }
+    std::memcpy(p_first, buffer.data(), static_cast< std::size_t >(length));
+    return {p_first + length, std::errc{}};
+}
+
+auto mt::FormatPattern::formatUnchecked(char* p_first,
+                                        const std::chrono::year_month_day p_date,
+                                        const std::chrono::nanoseconds p_since_day_start,
+                                        const std::chrono::seconds p_offset) const noexcept -> char* {
+    const auto nanoseconds = static_cast< uint64_t >(p_since_day_start.count());
+    const auto seconds = nanoseconds / 1'000'000'000;
+    for (std::size_t i = 0; i < m_operations_count; ++i) {
+        const auto& operation = m_operations[i];
+        switch (operation.specifier) {
+            case Specifier::Literal: {
+                std::memcpy(p_first, m_literals.data() + operation.position, operation.length);
+                p_first += operation.length;
+                break;
+            }
+            case Specifier::Year: {
+                const auto year = static_cast< int32_t >(p_date.year());
+                if (year < 0) {
+                    *p_first++ = '-';
+                }
+                const auto absolute = static_cast< uint64_t >(year < 0 ? -year : year);
+                p_first = writeDigits(p_first, absolute, absolute > 9999 ? 5 : 4);
+                break;
+            }
+            case Specifier::Month: {
+                p_first = writeDigits(p_first, static_cast< uint32_t >(p_date.month()), 2);
+                break;
+            }
+            case Specifier::Day: {
+                p_first = writeDigits(p_first, static_cast< uint32_t >(p_date.day()), 2);
+                break;
+            }
+            case Specifier::DayOfYear: {
+                const auto day_of_year = std::chrono::sys_days{p_date} - std::chrono::sys_days{p_date.year() / std::chrono::January / 1} + std::chrono::days{1};
+                p_first = writeDigits(p_first, static_cast< uint64_t >(day_of_year.count()), 3);
+                break;
+            }
+            case Specifier::WeekDay: {
+                p_first = writeDigits(p_first, std::chrono::weekday{std::chrono::sys_days{p_date}}.iso_encoding(), 1);
+                break;
+            }
+            case Specifier::Hours: {
+                p_first = writeDigits(p_first, seconds / 3600, 2);
+                break;
+            }
+            case Specifier::Minutes: {
+                p_first = writeDigits(p_first, seconds / 60 % 60, 2);
+                break;
+            }
+            case Specifier::Seconds: {
+                p_first = writeDigits(p_first, seconds % 60, 2);
+                break;
+            }
+            case Specifier::Fraction: {
+                const auto fraction = nanoseconds % 1'000'000'000 / static_cast< uint64_t >(powers_of_ten[9 - operation.length]);
+                p_first = writeDigits(p_first, fraction, operation.length);
+                break;
+            }
+            case Specifier::Offset: {
+                p_first = writeOffset(p_first, p_offset, false);
+                break;
+            }
+            case Specifier::OffsetExtended: {
+                p_first = writeOffset(p_first, p_offset, true);
+                break;
+            }
+            case Specifier::OffsetDesignator: {
+                if (p_offset == std::chrono::seconds{0}) {
+                    *p_first++ = 'Z';
+                } else {
+                    p_first = writeOffset(p_first, p_offset, true);
+                }
+                break;
+            }
+        }
+    }
+    return p_first;
+}
@@ -0,0 +1,25 @@
+#include "instruction_set.hpp"
+
+namespace {
+    auto detectInstructionSet() noexcept -> mt::InstructionSet;
+}  // End of unnamed namespace
+
+auto mt::supportedInstructionSet() noexcept -> mt::InstructionSet {
+    static const auto instruction_set = detectInstructionSet();
+    return instruction_set;
+}
+
+namespace {
+    auto detectInstructionSet() noexcept -> mt::InstructionSet {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return mt::InstructionSet::AVX2;
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return mt::InstructionSet::SSE42;
+        }
+#endif
+        return mt::InstructionSet::Scalar;
+    }
+}  // End of unnamed namespace
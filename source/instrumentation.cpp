@@ -0,0 +1,188 @@
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <vector>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #include <x86intrin.h>
+#else
+  #include <chrono>
+#endif
+
+namespace {
+    /**
+     * \brief Counters of one thread. Only the owning thread writes them, so increments are plain relaxed load and store,
+     * atomics are used only to let snapshot() read them concurrently.
+     */
+    struct Counters {
+        std::array< std::atomic< uint64_t >, mt::instrumentation::counters_count > counters{};
+        std::array< std::atomic< uint64_t >, mt::instrumentation::failure_reasons_count > parse_failures{};
+        std::array< std::array< std::atomic< uint64_t >, mt::instrumentation::histogram_buckets >, mt::instrumentation::histograms_count > histograms{};
+    };
+
+    /**
+     * \brief Counters of live threads and the sum of counters of exited ones.
+     */
+    struct Registry {
+        std::mutex mutex;
+        std::vector< Counters* > threads;
+        mt::instrumentation::Snapshot exited;
+    };
+
+    /**
+     * \brief Registers counters of the thread on its first event and folds them into Registry::exited when the thread exits.
+     */
+    struct ThreadCounters {
+        Counters counters;
+
+        ThreadCounters();
+        ThreadCounters(const ThreadCounters&) = delete;
+        ThreadCounters(ThreadCounters&&) = delete;
+        auto operator=(const ThreadCounters&) -> ThreadCounters& = delete;
+        auto operator=(ThreadCounters&&) -> ThreadCounters& = delete;
+        ~ThreadCounters();
+    };
+
+    std::atomic< bool > histograms_enabled{false};
+
+    constexpr std::array< std::string_view, mt::instrumentation::counters_count > counter_names{
+        "date_parses",
+        "time_parses",
+        "date_time_parses",
+        "date_invalid_argument",
+        "date_range_error",
+        "time_invalid_argument",
+        "time_range_error",
+        "date_time_runtime_error",
+        "string_allocations",
+        "clock_reads",
+        "localtime_calls",
+    };
+    constexpr std::array< std::string_view, mt::instrumentation::failure_reasons_count > failure_names{
+        "invalid_length",
+        "invalid_character",
+        "invalid_month",
+        "invalid_day",
+        "invalid_hours",
+        "invalid_minutes",
+        "invalid_seconds",
+        "invalid_offset",
+    };
+    constexpr std::array< std::string_view, mt::instrumentation::histograms_count > histogram_names{
+        "date_parse_cycles",
+        "time_parse_cycles",
+        "date_time_parse_cycles",
+    };
+
+    auto registry() -> Registry&;
+    auto local() noexcept -> Counters&;
+    void increment(std::atomic< uint64_t >& p_counter) noexcept;
+    void add(const Counters& p_counters, mt::instrumentation::Snapshot& p_snapshot);
+    void clear(Counters& p_counters);
+}  // End of unnamed namespace
+
+void mt::instrumentation::detail::count(const Counter p_counter) noexcept { increment(local().counters[static_cast< std::size_t >(p_counter)]); }
+
+void mt::instrumentation::detail::countFailure(const parser::ErrorCode p_reason) noexcept {
+    increment(local().parse_failures[static_cast< std::size_t >(p_reason)]);
+}
+
+auto mt::instrumentation::detail::histogramsEnabled() noexcept -> bool { return histograms_enabled.load(std::memory_order_relaxed); }
+
+auto mt::instrumentation::detail::cycles() noexcept -> uint64_t {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#else
+    return static_cast< uint64_t >(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+void mt::instrumentation::detail::record(const Histogram p_histogram, const uint64_t p_cycles) noexcept {
+    const auto bucket = std::min< std::size_t >(static_cast< std::size_t >(std::bit_width(p_cycles)), histogram_buckets - 1);
+    increment(local().histograms[static_cast< std::size_t >(p_histogram)][bucket]);
+}
+
+void mt::instrumentation::enableHistograms(const bool p_enabled) noexcept { histograms_enabled.store(p_enabled, std::memory_order_relaxed); }
+
+auto mt::instrumentation::snapshot() -> Snapshot {
+    auto& state = registry();
+    const std::scoped_lock lock{state.mutex};
+    auto result = state.exited;
+    for (const auto* counters: state.threads) {
+        add(*counters, result);
+    }
+    return result;
+}
+
+void mt::instrumentation::reset() {
+    auto& state = registry();
+    const std::scoped_lock lock{state.mutex};
+    state.exited = Snapshot{};
+    for (auto* counters: state.threads) {
+        clear(*counters);
+    }
+}
+
+auto mt::instrumentation::name(const Counter p_counter) noexcept -> std::string_view { return counter_names[static_cast< std::size_t >(p_counter)]; }
+
+auto mt::instrumentation::name(const parser::ErrorCode p_reason) noexcept -> std::string_view { return failure_names[static_cast< std::size_t >(p_reason)]; }
+
+auto mt::instrumentation::name(const Histogram p_histogram) noexcept -> std::string_view { return histogram_names[static_cast< std::size_t >(p_histogram)]; }
+
+namespace {
+    ThreadCounters::ThreadCounters() {
+        auto& state = registry();
+        const std::scoped_lock lock{state.mutex};
+        state.threads.push_back(&counters);
+    }
+
+    ThreadCounters::~ThreadCounters() {
+        auto& state = registry();
+        const std::scoped_lock lock{state.mutex};
+        add(counters, state.exited);
+        std::erase(state.threads, &counters);
+    }
+
+    auto registry() -> Registry& {
+        // Never destroyed, so threads which exit during static destruction still find it.
+        static auto* const state = new Registry{};
+        return *state;
+    }
+
+    auto local() noexcept -> Counters& {
+        thread_local ThreadCounters thread_counters;
+        return thread_counters.counters;
+    }
+
+    void increment(std::atomic< uint64_t >& p_counter) noexcept { p_counter.store(p_counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+    void add(const Counters& p_counters, mt::instrumentation::Snapshot& p_snapshot) {
+        for (std::size_t i = 0; i < p_counters.counters.size(); ++i) {
+            p_snapshot.counters[i] += p_counters.counters[i].load(std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < p_counters.parse_failures.size(); ++i) {
+            p_snapshot.parse_failures[i] += p_counters.parse_failures[i].load(std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < p_counters.histograms.size(); ++i) {
+            for (std::size_t bucket = 0; bucket < p_counters.histograms[i].size(); ++bucket) {
+                p_snapshot.histograms[i][bucket] += p_counters.histograms[i][bucket].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void clear(Counters& p_counters) {
+        for (auto& counter: p_counters.counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (auto& counter: p_counters.parse_failures) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (auto& histogram: p_counters.histograms) {
+            for (auto& counter: histogram) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}  // End of unnamed namespace
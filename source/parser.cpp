@@ -0,0 +1,327 @@
+#include "parser.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define MT_PARSER_X86_SIMD
+  #include <immintrin.h>
+#endif
+
+namespace {
+
+    /**
+     * \brief Size of zero padded buffer the input is copied to before vector loads.
+     */
+    constexpr std::size_t buffer_size{64};
+    /**
+     * \brief Maximal length of supported layout: YYYY-MM-DDTHH:MM:SS.mmm.mmm.nnn+HH:MM
+     */
+    constexpr std::size_t max_layout_length{37};
+    /**
+     * \brief Number of 4 byte lanes decoded fields are gathered into.
+     */
+    constexpr std::size_t fields_count{12};
+
+    enum Field : uint8_t {
+        Year,
+        Month,
+        Day,
+        Hours,
+        Minutes,
+        Seconds,
+        Milliseconds,
+        Microseconds,
+        Nanoseconds,
+        OffsetHours,
+        OffsetMinutes,
+    };
+
+    /**
+     * \brief Fixed width layout description.
+     * \li expected - literal characters at separator positions and zeroes everywhere else.
+     * \li digits - 0xFF at positions of digits.
+     * \li shuffle - pshufb masks, per output vector and per 16 bytes input chunk, which gather digits into right aligned 4 bytes lanes.
+     */
+    struct Layout {
+        alignas(64) std::array< uint8_t, buffer_size > expected{};
+        alignas(64) std::array< uint8_t, buffer_size > digits{};
+        alignas(16) std::array< std::array< std::array< uint8_t, 16 >, 3 >, 3 > shuffle{};
+        uint8_t length{0};
+        uint8_t sign_pos{0};
+    };
+
+    constexpr std::array< std::size_t, 2 > date_lengths{8, 10};
+    constexpr std::array< std::size_t, 5 > time_lengths{5, 8, 12, 16, 20};
+    constexpr std::array< std::size_t, 4 > offset_lengths{0, 1, 3, 6};
+    constexpr std::size_t layouts_count{date_lengths.size() * time_lengths.size() * offset_lengths.size()};
+
+    constexpr auto layoutIndex(const std::size_t p_date, const std::size_t p_time, const std::size_t p_offset) -> std::size_t {
+        return (p_date * time_lengths.size() + p_time) * offset_lengths.size() + p_offset;
+    }
+
+    consteval auto makeLayout(const std::size_t p_date, const std::size_t p_time, const std::size_t p_offset) -> Layout {
+        Layout layout;
+        for (auto& vector: layout.shuffle) {
+            for (auto& chunk: vector) {
+                chunk.fill(0x80);
+            }
+        }
+        const auto literal = [&layout](const std::size_t p_pos, const char p_character) {
+            layout.expected[p_pos] = static_cast< uint8_t >(p_character);
+        };
+        const auto field = [&layout](const Field p_field, const std::size_t p_pos, const std::size_t p_width) {
+            for (std::size_t i = 0; i < p_width; ++i) {
+                const auto source = p_pos + i;
+                const auto destination = p_field * 4 + 4 - p_width + i;
+                layout.digits[source] = 0xFF;
+                layout.shuffle[destination / 16][source / 16][destination % 16] = static_cast< uint8_t >(source % 16);
+            }
+        };
+
+        const auto date_length = date_lengths[p_date];
+        field(Year, 0, 4);
+        if (date_length == 10) {
+            literal(4, '-');
+            field(Month, 5, 2);
+            literal(7, '-');
+            field(Day, 8, 2);
+        } else {
+            field(Month, 4, 2);
+            field(Day, 6, 2);
+        }
+        literal(date_length, 'T');
+
+        const auto time_pos = date_length + 1;
+        const auto time_length = time_lengths[p_time];
+        constexpr std::array< std::size_t, 6 > fields_pos{0, 3, 6, 9, 13, 17};
+        constexpr std::array< std::size_t, 6 > fields_width{2, 2, 2, 3, 3, 3};
+        constexpr std::array< char, 6 > separators{'\0', ':', ':', '.', '.', '.'};
+        for (std::size_t i = 0; i < fields_pos.size() && fields_pos[i] < time_length; ++i) {
+            if (i > 0) {
+                literal(time_pos + fields_pos[i] - 1, separators[i]);
+            }
+            field(static_cast< Field >(Hours + i), time_pos + fields_pos[i], fields_width[i]);
+        }
+
+        const auto offset_pos = time_pos + time_length;
+        switch (offset_lengths[p_offset]) {
+            case 1: {
+                literal(offset_pos, 'Z');
+                break;
+            }
+            case 6: {
+                literal(offset_pos + 3, ':');
+                field(OffsetMinutes, offset_pos + 4, 2);
+                [[fallthrough]];
+            }
+            case 3: {
+                // Sign is verified during layout detection and replaced with '+' before validation.
+                literal(offset_pos, '+');
+                field(OffsetHours, offset_pos + 1, 2);
+                layout.sign_pos = static_cast< uint8_t >(offset_pos);
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+        layout.length = static_cast< uint8_t >(offset_pos + offset_lengths[p_offset]);
+        return layout;
+    }
+
+    consteval auto makeLayouts() -> std::array< Layout, layouts_count > {
+        std::array< Layout, layouts_count > layouts;
+        for (std::size_t date = 0; date < date_lengths.size(); ++date) {
+            for (std::size_t time = 0; time < time_lengths.size(); ++time) {
+                for (std::size_t offset = 0; offset < offset_lengths.size(); ++offset) {
+                    layouts[layoutIndex(date, time, offset)] = makeLayout(date, time, offset);
+                }
+            }
+        }
+        return layouts;
+    }
+
+    constinit const std::array< Layout, layouts_count > layouts = makeLayouts();
+
+    auto detectLayout(std::string_view p_date_time) noexcept -> const Layout*;
+    auto assemble(const std::array< int32_t, fields_count >& p_fields, bool p_negative_offset) noexcept -> std::expected< mt::parser::DateTimeFields, mt::parser::Error >;
+#if defined MT_PARSER_X86_SIMD
+    auto parseSSE42(const Layout& p_layout, const uint8_t* p_buffer, std::array< int32_t, fields_count >& p_fields) noexcept -> bool;
+    auto parseAVX2(const Layout& p_layout, const uint8_t* p_buffer, std::array< int32_t, fields_count >& p_fields) noexcept -> bool;
+#endif
+}  // End of unnamed namespace
+
+auto mt::parser::parseDateTimeFast(const std::string_view p_date_time) noexcept -> std::expected< DateTimeFields, Error > {
+    return parseDateTimeFast(p_date_time, mt::supportedInstructionSet());
+}
+
+auto mt::parser::parseDateTimeFast(const std::string_view p_date_time, const InstructionSet p_instruction_set) noexcept -> std::expected< DateTimeFields, Error > {
+    const auto instruction_set = std::min(p_instruction_set, mt::supportedInstructionSet());
+    const auto* const layout = detectLayout(p_date_time);
+    if (instruction_set == InstructionSet::Scalar || layout == nullptr) {
+        return parseDateTime(p_date_time);
+    }
+    alignas(64) std::array< uint8_t, buffer_size > buffer{};
+    std::memcpy(buffer.data(), p_date_time.data(), p_date_time.length());
+    const bool negative_offset = layout->sign_pos != 0 && buffer[layout->sign_pos] == '-';
+    if (layout->sign_pos != 0) {
+        buffer[layout->sign_pos] = '+';
+    }
+    std::array< int32_t, fields_count > fields{};
+    bool valid = false;
+#if defined MT_PARSER_X86_SIMD
+    if (instruction_set == InstructionSet::AVX2) {
+        valid = parseAVX2(*layout, buffer.data(), fields);
+    } else {
+        valid = parseSSE42(*layout, buffer.data(), fields);
+    }
+#endif
+    if (valid) {
+        if (auto result = assemble(fields, negative_offset); result) {
+            return result;
+        }
+    }
+    // Errors are reported by scalar parser, so codes and positions do not depend on the code path taken.
+    return parseDateTime(p_date_time);
+}
+
+namespace {
+    auto detectLayout(const std::string_view p_date_time) noexcept -> const Layout* {
+        const auto length = p_date_time.length();
+        if (length < date_lengths[0] + 1 + time_lengths[0] || length > max_layout_length) {
+            return nullptr;
+        }
+        const std::size_t date = p_date_time[4] == '-' ? 1 : 0;
+        const auto date_length = date_lengths[date];
+        if (p_date_time[date_length] != 'T') {
+            return nullptr;
+        }
+        const auto rest = length - date_length - 1;
+        std::size_t offset = 0;
+        if (p_date_time[length - 1] == 'Z') {
+            offset = 1;
+        } else if (rest >= 6 && p_date_time[length - 3] == ':' && (p_date_time[length - 6] == '+' || p_date_time[length - 6] == '-')) {
+            offset = 3;
+        } else if (p_date_time[length - 3] == '+' || p_date_time[length - 3] == '-') {
+            offset = 2;
+        }
+        if (rest < offset_lengths[offset]) {
+            return nullptr;
+        }
+        std::size_t time = 0;
+        switch (rest - offset_lengths[offset]) {
+            case 5: {
+                time = 0;
+                break;
+            }
+            case 8: {
+                time = 1;
+                break;
+            }
+            case 12: {
+                time = 2;
+                break;
+            }
+            case 16: {
+                time = 3;
+                break;
+            }
+            case 20: {
+                time = 4;
+                break;
+            }
+            default: {
+                return nullptr;
+            }
+        }
+        return &layouts[layoutIndex(date, time, offset)];
+    }
+
+    auto assemble(const std::array< int32_t, fields_count >& p_fields, const bool p_negative_offset) noexcept -> std::expected< mt::parser::DateTimeFields, mt::parser::Error > {
+        const std::chrono::year_month_day date{
+            std::chrono::year{p_fields[Year]}, std::chrono::month{static_cast< uint32_t >(p_fields[Month])}, std::chrono::day{static_cast< uint32_t >(p_fields[Day])}};
+        // Only validity matters here, detailed error is produced by scalar parser.
+        constexpr mt::parser::Error error{mt::parser::ErrorCode::InvalidCharacter, 0};
+        if (not date.ok() || p_fields[Hours] > 23 || p_fields[Minutes] > 59 || p_fields[Seconds] > 59 || p_fields[OffsetHours] > 12 || p_fields[OffsetMinutes] != 0) {
+            return std::unexpected(error);
+        }
+        const auto since_day_start = std::chrono::hours{p_fields[Hours]} + std::chrono::minutes{p_fields[Minutes]} + std::chrono::seconds{p_fields[Seconds]}
+                                   + std::chrono::milliseconds{p_fields[Milliseconds]} + std::chrono::microseconds{p_fields[Microseconds]}
+                                   + std::chrono::nanoseconds{p_fields[Nanoseconds]};
+        const auto offset = static_cast< int8_t >(p_negative_offset ? -p_fields[OffsetHours] : p_fields[OffsetHours]);
+        return mt::parser::DateTimeFields{date, mt::parser::TimeFields{since_day_start, static_cast< mt::TimeZone >(offset)}};
+    }
+
+#if defined MT_PARSER_X86_SIMD
+    /**
+     * \brief Gathers digits into 4 byte lanes and converts each lane into 32 bit integer.
+     * \param p_chunks Input chunks with '0' already subtracted.
+     */
+    __attribute__((target("sse4.2"))) inline void decodeFields(const Layout& p_layout, const __m128i (&p_chunks)[3], std::array< int32_t, fields_count >& p_fields) noexcept {
+        const auto pairs_weights = _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1);
+        const auto quads_weights = _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1);
+        for (std::size_t vector = 0; vector < 3; ++vector) {
+            auto gathered = _mm_setzero_si128();
+            for (std::size_t chunk = 0; chunk < 3; ++chunk) {
+                const auto mask = _mm_load_si128(reinterpret_cast< const __m128i* >(p_layout.shuffle[vector][chunk].data()));
+                gathered = _mm_or_si128(gathered, _mm_shuffle_epi8(p_chunks[chunk], mask));
+            }
+            const auto pairs = _mm_maddubs_epi16(gathered, pairs_weights);
+            const auto quads = _mm_madd_epi16(pairs, quads_weights);
+            _mm_storeu_si128(reinterpret_cast< __m128i* >(p_fields.data() + vector * 4), quads);
+        }
+    }
+
+    __attribute__((target("sse4.2"))) auto parseSSE42(const Layout& p_layout, const uint8_t* const p_buffer, std::array< int32_t, fields_count >& p_fields) noexcept -> bool {
+        const auto zero = _mm_set1_epi8('0');
+        const auto nine = _mm_set1_epi8(9);
+        __m128i chunks[3];
+        int valid = 0xFFFF;
+        for (std::size_t chunk = 0; chunk < buffer_size / 16; ++chunk) {
+            const auto input = _mm_load_si128(reinterpret_cast< const __m128i* >(p_buffer + chunk * 16));
+            const auto expected = _mm_load_si128(reinterpret_cast< const __m128i* >(p_layout.expected.data() + chunk * 16));
+            const auto digits_mask = _mm_load_si128(reinterpret_cast< const __m128i* >(p_layout.digits.data() + chunk * 16));
+            const auto values = _mm_sub_epi8(input, zero);
+            const auto is_digit = _mm_cmpeq_epi8(_mm_min_epu8(values, nine), values);
+            const auto is_literal = _mm_cmpeq_epi8(input, expected);
+            valid &= _mm_movemask_epi8(_mm_or_si128(_mm_and_si128(digits_mask, is_digit), _mm_andnot_si128(digits_mask, is_literal)));
+            if (chunk < 3) {
+                chunks[chunk] = _mm_and_si128(values, digits_mask);
+            }
+        }
+        if (valid != 0xFFFF) {
+            return false;
+        }
+        decodeFields(p_layout, chunks, p_fields);
+        return true;
+    }
+
+    __attribute__((target("avx2"))) auto parseAVX2(const Layout& p_layout, const uint8_t* const p_buffer, std::array< int32_t, fields_count >& p_fields) noexcept -> bool {
+        const auto zero = _mm256_set1_epi8('0');
+        const auto nine = _mm256_set1_epi8(9);
+        __m256i values[2];
+        __m256i digits_mask[2];
+        uint32_t valid = 0xFFFFFFFF;
+        for (std::size_t half = 0; half < 2; ++half) {
+            const auto input = _mm256_load_si256(reinterpret_cast< const __m256i* >(p_buffer + half * 32));
+            const auto expected = _mm256_load_si256(reinterpret_cast< const __m256i* >(p_layout.expected.data() + half * 32));
+            digits_mask[half] = _mm256_load_si256(reinterpret_cast< const __m256i* >(p_layout.digits.data() + half * 32));
+            values[half] = _mm256_sub_epi8(input, zero);
+            const auto is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(values[half], nine), values[half]);
+            const auto is_literal = _mm256_cmpeq_epi8(input, expected);
+            valid &= static_cast< uint32_t >(
+                _mm256_movemask_epi8(_mm256_or_si256(_mm256_and_si256(digits_mask[half], is_digit), _mm256_andnot_si256(digits_mask[half], is_literal))));
+        }
+        if (valid != 0xFFFFFFFF) {
+            return false;
+        }
+        const auto low = _mm256_and_si256(values[0], digits_mask[0]);
+        const auto high = _mm256_and_si256(values[1], digits_mask[1]);
+        const __m128i chunks[3]{_mm256_castsi256_si128(low), _mm256_extracti128_si256(low, 1), _mm256_castsi256_si128(high)};
+        decodeFields(p_layout, chunks, p_fields);
+        return true;
+    }
+#endif
+}  // End of unnamed namespace
@@ -0,0 +1,251 @@
+#include "recurrence.hpp"
+
+#include <bit>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+    /**
+     * \brief Number of months in Gregorian calendar cycle. 400 years are exactly 20871 weeks, so days of the week repeat with the cycle as well.
+     */
+    constexpr int64_t cycle_months{4800};
+    /**
+     * \brief If this many periods in a row do not contain occurrence, none of the following will.
+     */
+    constexpr int64_t max_skipped_periods{cycle_months};
+
+    auto dayOf(const mt::date::Date& p_date) noexcept -> int32_t;
+    auto dateOf(int64_t p_day) noexcept -> mt::date::Date;
+    auto instantOf(const mt::date_time::DateTime& p_moment) noexcept -> std::pair< int64_t, int64_t >;
+}  // End of unnamed namespace
+
+mt::date_time::Recurrence::Recurrence(const DateTime& p_start, const RecurrenceRule& p_rule) :
+    m_start(p_start),
+    m_rule(p_rule) {
+    if (m_rule.interval == 0) {
+        throw std::invalid_argument("mt::date_time::Recurrence: [interval] should be greater than 0");
+    }
+    if (m_rule.ordinal != 0) {
+        if (m_rule.frequency != Frequency::Monthly || std::popcount(m_rule.week_days) != 1 || m_rule.ordinal < -5 || m_rule.ordinal > 5) {
+            throw std::invalid_argument("mt::date_time::Recurrence: [ordinal] requires Monthly frequency, one day of the week and value between -5 and 5");
+        }
+    }
+    const auto start_week_day = m_start.date().weekDay();
+    if (m_rule.frequency == Frequency::Weekly && m_rule.week_days == 0) {
+        m_rule.week_days = weekDayBit(start_week_day);
+    }
+    m_start_day = dayOf(m_start.date());
+    m_week_start = m_start_day - static_cast< int32_t >(start_week_day.iso_encoding() - 1);
+    if (m_rule.until) {
+        m_until = instantOf(*m_rule.until);
+    }
+    for (uint8_t slot = 0; slot < (m_rule.frequency == Frequency::Weekly ? 7 : 1); ++slot) {
+        if (const auto day = candidate(0, slot); day && *day >= m_start_day) {
+            ++m_first_period_count;
+        }
+    }
+    if (m_rule.ordinal == 5 || m_rule.ordinal == -5) {
+        // Periods land on the same months of the calendar cycle again after this many periods.
+        m_cycle_periods = static_cast< uint16_t >(cycle_months / std::gcd(static_cast< int64_t >(m_rule.interval), cycle_months));
+        m_cycle_count = static_cast< uint16_t >(periodsWithOccurrence(m_cycle_periods));
+    }
+}
+
+auto mt::date_time::Recurrence::begin() const -> Iterator { return Iterator{*this, 0, 0}; }
+
+auto mt::date_time::Recurrence::after(const DateTime& p_moment) const -> std::ranges::subrange< Iterator, std::default_sentinel_t > {
+    const auto moment = localKey(p_moment);
+    const auto interval = static_cast< int64_t >(m_rule.interval);
+    int64_t period{0};
+    switch (m_rule.frequency) {
+        case Frequency::Daily: {
+            period = (moment.first - m_start_day) / interval;
+            break;
+        }
+        case Frequency::Weekly: {
+            period = (moment.first - m_week_start) / (7 * interval);
+            break;
+        }
+        case Frequency::Monthly: {
+            const auto start = m_start.date().date();
+            const auto date = dateOf(moment.first).date();
+            const auto months = (static_cast< int64_t >(static_cast< int32_t >(date.year())) - static_cast< int32_t >(start.year())) * 12
+                              + static_cast< uint32_t >(date.month()) - static_cast< uint32_t >(start.month());
+            period = months / interval;
+            break;
+        }
+        case Frequency::Yearly: {
+            period = (static_cast< int64_t >(dateOf(moment.first).year< int32_t >()) - m_start.date().year< int32_t >()) / interval;
+            break;
+        }
+    }
+    period = std::max< int64_t >(period, 0);
+    Iterator iterator{*this, period, occurrencesBefore(period)};
+    const auto instant = instantOf(p_moment);
+    while (iterator != std::default_sentinel && instantOf(occurrence(iterator.m_day)) <= instant) {
+        ++iterator;
+    }
+    return {iterator, std::default_sentinel};
+}
+
+auto mt::date_time::Recurrence::candidate(const int64_t p_period, const uint8_t p_slot) const -> std::optional< int32_t > {
+    const auto step = p_period * static_cast< int64_t >(m_rule.interval);
+    switch (m_rule.frequency) {
+        case Frequency::Daily: {
+            return static_cast< int32_t >(m_start_day + step);
+        }
+        case Frequency::Weekly: {
+            // Slot 0 is Monday, so slot + 1 is ISO encoding of the day of the week.
+            if ((m_rule.week_days >> ((p_slot + 1) % 7) & 1U) == 0) {
+                return std::nullopt;
+            }
+            return static_cast< int32_t >(m_week_start + step * 7 + p_slot);
+        }
+        case Frequency::Monthly: {
+            if (m_rule.ordinal == 0) {
+                return dayOf(m_start.date() + std::chrono::months{step});
+            }
+            const auto start = m_start.date().date();
+            const auto month = std::chrono::year_month{start.year(), start.month()} + std::chrono::months{step};
+            const std::chrono::weekday week_day{static_cast< uint32_t >(std::countr_zero(m_rule.week_days))};
+            if (m_rule.ordinal > 0) {
+                const std::chrono::year_month_weekday date{month.year(), month.month(), week_day[static_cast< uint32_t >(m_rule.ordinal)]};
+                if (not date.ok()) {
+                    return std::nullopt;
+                }
+                return static_cast< int32_t >(std::chrono::sys_days{date}.time_since_epoch().count());
+            }
+            const auto day = std::chrono::sys_days{std::chrono::year_month_weekday_last{month.year(), month.month(), week_day[std::chrono::last]}}
+                           - std::chrono::weeks{-m_rule.ordinal - 1};
+            if (std::chrono::year_month_day{day}.month() != month.month()) {
+                return std::nullopt;
+            }
+            return static_cast< int32_t >(day.time_since_epoch().count());
+        }
+        case Frequency::Yearly: {
+            return dayOf(m_start.date() + std::chrono::years{step});
+        }
+    }
+    return std::nullopt;
+}
+
+auto mt::date_time::Recurrence::occurrencesBefore(const int64_t p_period) const -> uint64_t {
+    if (p_period == 0) {
+        return 0;
+    }
+    const auto following = static_cast< uint64_t >(p_period - 1);
+    switch (m_rule.frequency) {
+        case Frequency::Weekly: {
+            return m_first_period_count + following * static_cast< uint64_t >(std::popcount(m_rule.week_days));
+        }
+        case Frequency::Monthly: {
+            // Fifth day of the week exists only in some months, which repeat with the calendar cycle.
+            if (m_rule.ordinal == 5 || m_rule.ordinal == -5) {
+                return m_first_period_count + following / m_cycle_periods * m_cycle_count + periodsWithOccurrence(following % m_cycle_periods);
+            }
+            return m_first_period_count + following;
+        }
+        default: {
+            return m_first_period_count + following;
+        }
+    }
+}
+
+auto mt::date_time::Recurrence::periodsWithOccurrence(const uint64_t p_periods) const -> uint64_t {
+    uint64_t result{0};
+    for (uint64_t period = 1; period <= p_periods; ++period) {
+        result += candidate(static_cast< int64_t >(period), 0).has_value();
+    }
+    return result;
+}
+
+auto mt::date_time::Recurrence::occurrence(const int32_t p_day) const -> DateTime {
+    if (const auto zone = m_start.time().zone(); zone != ZoneId::None) {
+        return DateTime{dateOf(p_day), m_start.time(), zone};
+    }
+    return DateTime{dateOf(p_day), m_start.time()};
+}
+
+auto mt::date_time::Recurrence::localKey(const DateTime& p_moment) const -> std::pair< int64_t, int64_t > {
+    if (const auto zone = m_start.time().zone(); zone != ZoneId::None) {
+        const auto [day, since_day_start] = instantOf(p_moment);
+        const auto utc = std::chrono::sys_days{std::chrono::days{day}} + std::chrono::floor< std::chrono::seconds >(std::chrono::nanoseconds{since_day_start});
+        auto nanoseconds = std::chrono::nanoseconds{since_day_start} + ZoneDatabase::zone(zone).offset(utc);
+        const auto carry = std::chrono::floor< std::chrono::days >(nanoseconds);
+        nanoseconds -= carry;
+        return {day + carry.count(), nanoseconds.count()};
+    }
+    auto nanoseconds = p_moment.time().sinceDayStart() + m_start.time().utcOffset() - p_moment.time().utcOffset();
+    const auto carry = std::chrono::floor< std::chrono::days >(nanoseconds);
+    nanoseconds -= carry;
+    return {dayOf(p_moment.date()) + carry.count(), nanoseconds.count()};
+}
+
+mt::date_time::Recurrence::Iterator::Iterator(const Recurrence& p_recurrence, const int64_t p_period, const uint64_t p_index) :
+    m_recurrence(&p_recurrence),
+    m_period(p_period),
+    m_index(p_index),
+    m_done(false) {
+    settle();
+}
+
+auto mt::date_time::Recurrence::Iterator::operator*() const -> DateTime { return m_recurrence->occurrence(m_day); }
+
+auto mt::date_time::Recurrence::Iterator::operator++() -> Iterator& {
+    ++m_index;
+    step();
+    settle();
+    return *this;
+}
+
+auto mt::date_time::Recurrence::Iterator::operator++(int) -> Iterator {
+    auto previous = *this;
+    ++*this;
+    return previous;
+}
+
+void mt::date_time::Recurrence::Iterator::step() noexcept {
+    if (m_recurrence->m_rule.frequency == Frequency::Weekly && ++m_slot < 7) {
+        return;
+    }
+    m_slot = 0;
+    ++m_period;
+}
+
+void mt::date_time::Recurrence::Iterator::settle() {
+    const auto& recurrence = *m_recurrence;
+    if (recurrence.m_rule.count && m_index >= *recurrence.m_rule.count) {
+        m_done = true;
+        return;
+    }
+    for (const auto first_period = m_period;;) {
+        if (const auto day = recurrence.candidate(m_period, m_slot); day && *day >= recurrence.m_start_day) {
+            m_day = *day;
+            break;
+        }
+        if (m_period - first_period > max_skipped_periods) {
+            m_done = true;
+            return;
+        }
+        step();
+    }
+    if (recurrence.m_until && instantOf(recurrence.occurrence(m_day)) > *recurrence.m_until) {
+        m_done = true;
+    }
+}
+
+namespace {
+    auto dayOf(const mt::date::Date& p_date) noexcept -> int32_t { return static_cast< int32_t >(p_date.sinceEpoch().time_since_epoch().count()); }
+
+    auto dateOf(const int64_t p_day) noexcept -> mt::date::Date { return mt::date::Date{std::chrono::sys_days{std::chrono::days{p_day}}}; }
+
+    /**
+     * \brief Returns moment as pair of UTC day and nanoseconds since its start, which unlike sinceEpoch() covers the whole Date range.
+     */
+    auto instantOf(const mt::date_time::DateTime& p_moment) noexcept -> std::pair< int64_t, int64_t > {
+        auto nanoseconds = p_moment.time().sinceDayStart() - p_moment.time().utcOffset();
+        const auto carry = std::chrono::floor< std::chrono::days >(nanoseconds);
+        nanoseconds -= carry;
+        return {dayOf(p_moment.date()) + carry.count(), nanoseconds.count()};
+    }
+}  // End of unnamed namespace
@@ -0,0 +1,290 @@
+#include "sort.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr std::size_t digit_bits{8};
+    constexpr std::size_t buckets{1 << digit_bits};
+    constexpr std::size_t passes{64 / digit_bits};
+    /**
+     * \brief Minimal number of keys per part which is worth splitting the work for.
+     */
+    constexpr std::size_t min_keys_per_part{1 << 16};
+    /**
+     * \brief Days since epoch range which sortKey may represent in int64_t nanoseconds.
+     */
+    constexpr int64_t min_key_days{-106'751};
+    constexpr int64_t max_key_days{106'750};
+
+    using Histogram = std::array< std::size_t, buckets >;
+
+    /**
+     * \brief Sorts keys, histograms and scatter are split into parts run by p_executor, or in the calling thread if it is nullptr.
+     */
+    template < bool WithValues >
+    void sortKeys(mt::batch::Executor* p_executor, uint64_t* p_keys, uint32_t* p_values, std::size_t p_size);
+    void checkValues(std::size_t p_keys_size, std::size_t p_values_size);
+    /**
+     * \brief Calls p_function for each part index, in the calling thread if there is no executor or only one part.
+     */
+    template < class Function >
+    void forEachPart(mt::batch::Executor* p_executor, std::size_t p_parts, Function&& p_function);
+    void sortDateTimes(mt::batch::Executor* p_executor, std::span< mt::date_time::PackedDateTime > p_date_times);
+    void sortDateTimes(mt::batch::Executor* p_executor, std::span< mt::date_time::DateTime > p_date_times);
+    void sortIndices(mt::batch::Executor* p_executor, std::span< const mt::date_time::DateTime > p_date_times, std::span< uint32_t > p_indices);
+    /**
+     * \brief Flips sign bit, so signed keys are ordered the same way as unsigned ones.
+     */
+    auto flipSign(std::span< int64_t > p_keys) noexcept -> std::span< uint64_t >;
+    template < class Type >
+    void merge(std::span< const Type > p_first, std::span< const Type > p_second, std::span< Type > p_output);
+}  // End of unnamed namespace
+
+auto mt::batch::sortKey(const date_time::DateTime& p_date_time) -> int64_t {
+    const auto days = p_date_time.date().sinceEpoch().time_since_epoch().count();
+    if (days < min_key_days || days > max_key_days) {
+        throw std::range_error("mt::batch::sortKey: date is out of supported range");
+    }
+    return (std::chrono::days{days} + p_date_time.time().sinceDayStart()).count();
+}
+
+void mt::batch::radixSort(const std::span< uint64_t > p_keys) { sortKeys< false >(nullptr, p_keys.data(), nullptr, p_keys.size()); }
+
+void mt::batch::radixSort(Executor& p_executor, const std::span< uint64_t > p_keys) { sortKeys< false >(&p_executor, p_keys.data(), nullptr, p_keys.size()); }
+
+void mt::batch::radixSort(const std::span< int64_t > p_keys) {
+    radixSort(flipSign(p_keys));
+    flipSign(p_keys);
+}
+
+void mt::batch::radixSort(Executor& p_executor, const std::span< int64_t > p_keys) {
+    radixSort(p_executor, flipSign(p_keys));
+    flipSign(p_keys);
+}
+
+void mt::batch::radixSort(const std::span< uint64_t > p_keys, const std::span< uint32_t > p_values) {
+    checkValues(p_keys.size(), p_values.size());
+    sortKeys< true >(nullptr, p_keys.data(), p_values.data(), p_keys.size());
+}
+
+void mt::batch::radixSort(Executor& p_executor, const std::span< uint64_t > p_keys, const std::span< uint32_t > p_values) {
+    checkValues(p_keys.size(), p_values.size());
+    sortKeys< true >(&p_executor, p_keys.data(), p_values.data(), p_keys.size());
+}
+
+void mt::batch::radixSort(const std::span< int64_t > p_keys, const std::span< uint32_t > p_values) {
+    checkValues(p_keys.size(), p_values.size());
+    radixSort(flipSign(p_keys), p_values);
+    flipSign(p_keys);
+}
+
+void mt::batch::radixSort(Executor& p_executor, const std::span< int64_t > p_keys, const std::span< uint32_t > p_values) {
+    checkValues(p_keys.size(), p_values.size());
+    radixSort(p_executor, flipSign(p_keys), p_values);
+    flipSign(p_keys);
+}
+
+void mt::batch::radixSort(const std::span< date_time::PackedDateTime > p_date_times) { sortDateTimes(nullptr, p_date_times); }
+
+void mt::batch::radixSort(Executor& p_executor, const std::span< date_time::PackedDateTime > p_date_times) { sortDateTimes(&p_executor, p_date_times); }
+
+void mt::batch::radixSort(const std::span< date_time::DateTime > p_date_times) { sortDateTimes(nullptr, p_date_times); }
+
+void mt::batch::radixSort(Executor& p_executor, const std::span< date_time::DateTime > p_date_times) { sortDateTimes(&p_executor, p_date_times); }
+
+void mt::batch::sortedIndices(const std::span< const date_time::DateTime > p_date_times, const std::span< uint32_t > p_indices) {
+    sortIndices(nullptr, p_date_times, p_indices);
+}
+
+void mt::batch::sortedIndices(Executor& p_executor, const std::span< const date_time::DateTime > p_date_times, const std::span< uint32_t > p_indices) {
+    sortIndices(&p_executor, p_date_times, p_indices);
+}
+
+void mt::batch::mergeSorted(const std::span< const int64_t > p_first, const std::span< const int64_t > p_second, const std::span< int64_t > p_output) {
+    merge(p_first, p_second, p_output);
+}
+
+void mt::batch::mergeSorted(const std::span< const uint64_t > p_first, const std::span< const uint64_t > p_second, const std::span< uint64_t > p_output) {
+    merge(p_first, p_second, p_output);
+}
+
+void mt::batch::mergeSorted(const std::span< const date_time::PackedDateTime > p_first,
+                            const std::span< const date_time::PackedDateTime > p_second,
+                            const std::span< date_time::PackedDateTime > p_output) {
+    merge(p_first, p_second, p_output);
+}
+
+namespace {
+    template < bool WithValues >
+    void sortKeys(mt::batch::Executor* const p_executor, uint64_t* p_keys, uint32_t* p_values, const std::size_t p_size) {
+        if (p_size < 2) {
+            return;
+        }
+        // Parts are fixed for the whole sort, since offsets of each pass are assigned part by part to keep the sort stable.
+        const auto parts = std::clamp< std::size_t >(p_size / min_keys_per_part, 1, p_executor == nullptr ? 1 : p_executor->threads());
+        const auto chunk = (p_size + parts - 1) / parts;
+
+        // Histograms of all digits are collected in one read of the keys.
+        std::vector< std::array< Histogram, passes > > histograms(parts);
+        forEachPart(p_executor, parts, [&histograms, p_keys, p_size, chunk](const std::size_t p_part) {
+            auto& histogram = histograms[p_part];
+            for (auto i = p_part * chunk; i < std::min(p_size, (p_part + 1) * chunk); ++i) {
+                for (std::size_t pass = 0; pass < passes; ++pass) {
+                    ++histogram[pass][(p_keys[i] >> (pass * digit_bits)) & (buckets - 1)];
+                }
+            }
+        });
+
+        std::vector< uint64_t > keys_buffer(p_size);
+        std::vector< uint32_t > values_buffer(WithValues ? p_size : 0);
+        auto* keys = p_keys;
+        auto* values = p_values;
+        auto* keys_output = keys_buffer.data();
+        auto* values_output = values_buffer.data();
+        std::vector< Histogram > offsets(parts);
+        for (std::size_t pass = 0; pass < passes; ++pass) {
+            const auto shift = pass * digit_bits;
+            const auto digit = (keys[0] >> shift) & (buckets - 1);
+            std::size_t same_digit = 0;
+            for (const auto& histogram: histograms) {
+                same_digit += histogram[pass][digit];
+            }
+            if (same_digit == p_size) {
+                continue;
+            }
+            if (parts > 1) {
+                // Previous passes moved keys between chunks, so per chunk counts of this digit are collected again.
+                forEachPart(p_executor, parts, [&offsets, keys, p_size, chunk, shift](const std::size_t p_part) {
+                    auto& histogram = offsets[p_part];
+                    histogram.fill(0);
+                    for (auto i = p_part * chunk; i < std::min(p_size, (p_part + 1) * chunk); ++i) {
+                        ++histogram[(keys[i] >> shift) & (buckets - 1)];
+                    }
+                });
+            } else {
+                offsets[0] = histograms[0][pass];
+            }
+            // Offsets are assigned bucket by bucket and part by part inside the bucket, which keeps the sort stable.
+            std::size_t offset = 0;
+            for (std::size_t bucket = 0; bucket < buckets; ++bucket) {
+                for (std::size_t part = 0; part < parts; ++part) {
+                    const auto count = offsets[part][bucket];
+                    offsets[part][bucket] = offset;
+                    offset += count;
+                }
+            }
+            forEachPart(p_executor, parts, [&offsets, keys, values, keys_output, values_output, p_size, chunk, shift](const std::size_t p_part) {
+                auto& position = offsets[p_part];
+                for (auto i = p_part * chunk; i < std::min(p_size, (p_part + 1) * chunk); ++i) {
+                    const auto destination = position[(keys[i] >> shift) & (buckets - 1)]++;
+                    keys_output[destination] = keys[i];
+                    if constexpr (WithValues) {
+                        values_output[destination] = values[i];
+                    }
+                }
+            });
+            std::swap(keys, keys_output);
+            std::swap(values, values_output);
+        }
+        if (keys != p_keys) {
+            std::copy(keys, keys + p_size, p_keys);
+            if constexpr (WithValues) {
+                std::copy(values, values + p_size, p_values);
+            }
+        }
+    }
+
+    void checkValues(const std::size_t p_keys_size, const std::size_t p_values_size) {
+        if (p_keys_size != p_values_size) {
+            throw std::invalid_argument("mt::batch: [values] column has " + std::to_string(p_values_size) + " rows, but " + std::to_string(p_keys_size)
+                                        + " rows are expected");
+        }
+        if (p_keys_size > std::numeric_limits< uint32_t >::max()) {
+            throw std::invalid_argument("mt::batch: number of rows exceeds the range of uint32_t values");
+        }
+    }
+
+    template < class Function >
+    void forEachPart(mt::batch::Executor* const p_executor, const std::size_t p_parts, Function&& p_function) {
+        if (p_executor == nullptr || p_parts == 1) {
+            for (std::size_t part = 0; part < p_parts; ++part) {
+                p_function(part);
+            }
+            return;
+        }
+        p_executor->forEachChunk(
+            p_parts,
+            [&p_function](const std::size_t p_first, const std::size_t p_last) {
+                for (auto part = p_first; part < p_last; ++part) {
+                    p_function(part);
+                }
+            },
+            1);
+    }
+
+    void sortDateTimes(mt::batch::Executor* const p_executor, const std::span< mt::date_time::PackedDateTime > p_date_times) {
+        std::vector< int64_t > keys(p_date_times.size());
+        std::ranges::transform(p_date_times, keys.begin(), [](const mt::date_time::PackedDateTime p_date_time) {
+            return p_date_time.sinceEpoch().count();
+        });
+        auto* const unsigned_keys = flipSign(keys).data();
+        sortKeys< false >(p_executor, unsigned_keys, nullptr, keys.size());
+        flipSign(keys);
+        std::ranges::transform(keys, p_date_times.begin(), [](const int64_t p_key) {
+            return mt::date_time::PackedDateTime{std::chrono::sys_time< std::chrono::nanoseconds >{std::chrono::nanoseconds{p_key}}};
+        });
+    }
+
+    void sortDateTimes(mt::batch::Executor* const p_executor, const std::span< mt::date_time::DateTime > p_date_times) {
+        std::vector< uint32_t > indices(p_date_times.size());
+        sortIndices(p_executor, p_date_times, indices);
+        const std::vector< mt::date_time::DateTime > source(p_date_times.begin(), p_date_times.end());
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            p_date_times[i] = source[indices[i]];
+        }
+    }
+
+    void sortIndices(mt::batch::Executor* const p_executor, const std::span< const mt::date_time::DateTime > p_date_times, const std::span< uint32_t > p_indices) {
+        checkValues(p_date_times.size(), p_indices.size());
+        std::vector< int64_t > keys(p_date_times.size());
+        std::ranges::transform(p_date_times, keys.begin(), mt::batch::sortKey);
+        std::iota(p_indices.begin(), p_indices.end(), uint32_t{0});
+        auto* const unsigned_keys = flipSign(keys).data();
+        sortKeys< true >(p_executor, unsigned_keys, p_indices.data(), keys.size());
+    }
+
+    auto flipSign(const std::span< int64_t > p_keys) noexcept -> std::span< uint64_t > {
+        // Aliasing rules allow access to int64_t through its unsigned counterpart.
+        auto* const keys = reinterpret_cast< uint64_t* >(p_keys.data());
+        for (std::size_t i = 0; i < p_keys.size(); ++i) {
+            keys[i] ^= uint64_t{1} << 63;
+        }
+        return {keys, p_keys.size()};
+    }
+
+    template < class Type >
+    void merge(const std::span< const Type > p_first, const std::span< const Type > p_second, const std::span< Type > p_output) {
+        if (p_output.size() != p_first.size() + p_second.size()) {
+            throw std::invalid_argument("mt::batch: [output] column has " + std::to_string(p_output.size()) + " rows, but "
+                                        + std::to_string(p_first.size() + p_second.size()) + " rows are expected");
+        }
+        std::size_t first = 0;
+        std::size_t second = 0;
+        std::size_t output = 0;
+        // Branchless selection: comparison result is used as an index increment instead of a jump.
+        while (first < p_first.size() && second < p_second.size()) {
+            const bool take_second = p_second[second] < p_first[first];
+            p_output[output++] = take_second ? p_second[second] : p_first[first];
+            second += take_second;
+            first += not take_second;
+        }
+        std::copy(p_first.begin() + static_cast< std::ptrdiff_t >(first), p_first.end(), p_output.begin() + static_cast< std::ptrdiff_t >(output));
+        std::copy(p_second.begin() + static_cast< std::ptrdiff_t >(second), p_second.end(), p_output.begin() + static_cast< std::ptrdiff_t >(output + p_first.size() - first));
+    }
+}  // End of unnamed namespace
@@ -1,15 +1,13 @@
 #include "time.hpp"
+#include "instrumentation.hpp"
 
 #include <chrono>
-#if defined __cpp_lib_format
-  #include <format>
-#endif
 namespace {
     auto checkTimeFormat(const std::string& time) -> bool;
 }  // End of unnamed namespace
 
 mt::time::Time::Time() {
-
+    mt::instrumentation::count(mt::instrumentation::Counter::ClockReads);
     const auto time_point = std::chrono::time_point_cast< std::chrono::nanoseconds >(std::chrono::system_clock::now());
     const auto days = std::chrono::time_point_cast< std::chrono::days >(time_point);
     m_nanoseconds_since_day_start = std::chrono::duration_cast< std::chrono::nanoseconds >(time_point - days);
@@ -17,6 +15,7 @@ mt::time::Time::Time() {
 
 mt::time::Time::Time(const mt::TimeZone p_time_zone) :
     m_offset(p_time_zone) {
+    mt::instrumentation::count(mt::instrumentation::Counter::ClockReads);
     auto time_point = std::chrono::time_point_cast< std::chrono::nanoseconds >(std::chrono::system_clock::now());
     time_point += std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::hours(static_cast< int8_t >(m_offset)));
     const auto days = std::chrono::time_point_cast< std::chrono::days >(time_point);
@@ -58,36 +57,42 @@ mt::time::Time::Time(const std::chrono::hours p_hours,
         const std::string message = "mt::time::Time(int hours, int minutes, int "
                                     "seconds): bad [hour] value was provided - "
                                     + std::to_string(hours) + ". The value from 0 to 23 is expected";
+        mt::instrumentation::count(mt::instrumentation::Counter::TimeRangeError);
         throw std::range_error{message};
     }
     if (const auto minutes = p_minutes.count(); minutes > 59) {
         const std::string message = "mt::time::Time(int hours, int minutes, int "
                                     "seconds): bad [minutes] value was provided - "
                                     + std::to_string(minutes) + ". The value from 0 to 59 is expected";
+        mt::instrumentation::count(mt::instrumentation::Counter::TimeRangeError);
         throw std::range_error{message};
     }
     if (const auto seconds = p_seconds.count(); seconds > 59) {
         const std::string message = "mt::time::Time(int hours, int minutes, int "
                                     "seconds): bad [seconds] value was provided - "
                                     + std::to_string(seconds) + ". The value from 0 to 59 is expected";
+        mt::instrumentation::count(mt::instrumentation::Counter::TimeRangeError);
         throw std::range_error{message};
     }
     if (const auto milliseconds = p_milliseconds.count(); milliseconds > 999) {
         const std::string message = "mt::time::Time(int hours, int minutes, int seconds, uint16_t "
                                     "milliseconds): bad [milliseconds] value was provided - "
                                     + std::to_string(milliseconds) + ". The value from 0 to 999 is expected";
+        mt::instrumentation::count(mt::instrumentation::Counter::TimeRangeError);
         throw std::range_error{message};
     }
     if (const auto nanoseconds = p_nanoseconds.count() > 999) {
         const std::string message = "mt::time::Time(int hours, int minutes, int seconds, uint16_t "
                                     "milliseconds): bad [nanoseconds] value was provided - "
                                     + std::to_string(nanoseconds) + ". The value from 0 to 999 is expected";
+        mt::instrumentation::count(mt::instrumentation::Counter::TimeRangeError);
         throw std::range_error{message};
     }
     if (const auto microseconds = p_microseconds.count(); microseconds > 999) {
         const std::string message = "mt::time::Time(int hours, int minutes, int seconds, uint16_t "
                                     "milliseconds): bad [microseconds] value was provided - "
                                     + std::to_string(microseconds) + ". The value from 0 to 999 is expected";
+        mt::instrumentation::count(mt::instrumentation::Counter::TimeRangeError);
         throw std::range_error{message};
     }
     m_nanoseconds_since_day_start += p_hours;
@@ -107,7 +112,8 @@ mt::time::Time::Time(const std::chrono::hours p_hours,
 }
 
 mt::time::Time::Time(const std::string& time) {
-
+    mt::instrumentation::count(mt::instrumentation::Counter::TimeParses);
+    const mt::instrumentation::CycleTimer timer{mt::instrumentation::Histogram::TimeParse};
     auto l_time = time;
 
     const auto offset_pos = l_time.find_first_of("-+");
@@ -117,6 +123,7 @@ mt::time::Time::Time(const std::string& time) {
         l_time.erase(offset_pos);
     }
     if (not checkTimeFormat(l_time)) {
+        mt::instrumentation::countThrow(mt::instrumentation::Counter::TimeInvalidArgument, mt::parser::ErrorCode::InvalidCharacter);
         throw std::invalid_argument{"mt::time::Time::Time(const std::string& "
                                     "time): Invalid time format"};
     }
@@ -180,6 +187,7 @@ mt::time::Time::Time(const std::string& time) {
             break;
         }
         default: {
+            mt::instrumentation::countThrow(mt::instrumentation::Counter::TimeInvalidArgument, mt::parser::ErrorCode::InvalidLength);
             throw std::invalid_argument{"mt::time::Time::Time(const std::string& "
                                         "time): Invalid time format"};
         }
@@ -189,9 +197,16 @@ mt::time::Time::Time(const std::string& time) {
     }
 }
 
-auto mt::time::Time::operator==(const mt::time::Time& other) const -> bool { return m_nanoseconds_since_day_start == other.m_nanoseconds_since_day_start; }
-
-auto mt::time::Time::operator<(const mt::time::Time& other) const -> bool { return m_nanoseconds_since_day_start < other.m_nanoseconds_since_day_start; }
+auto mt::time::Time::tryParse(const std::string_view p_time) noexcept -> std::expected< Time, mt::parser::Error > {
+    mt::instrumentation::count(mt::instrumentation::Counter::TimeParses);
+    const mt::instrumentation::CycleTimer timer{mt::instrumentation::Histogram::TimeParse};
+    const auto fields = mt::parser::parseTime(p_time);
+    if (not fields) {
+        mt::instrumentation::countFailure(fields.error().code);
+        return std::unexpected(fields.error());
+    }
+    return Time{fields->since_day_start, fields->offset};
+}
 
 void mt::time::Time::operator+=(const mt::time::Time& other) { *this = *this + other; }
 
@@ -201,7 +216,10 @@ void mt::time::Time::operator-=(const mt::time::Time& other) { *this = *this - o
 
 void mt::time::Time::operator-=(const TimeDuration p_value) { *this = *this - p_value; }
 
-void mt::time::Time::setOffset(const mt::TimeZone p_offset) { m_offset = p_offset; }
+void mt::time::Time::setOffset(const mt::TimeZone p_offset) {
+    m_offset = p_offset;
+    m_zone = ZoneId::None;
+}
 
 auto mt::time::Time::hours() const -> std::chrono::hours { return std::chrono::duration_cast< std::chrono::hours >(m_nanoseconds_since_day_start); }
 
@@ -223,55 +241,42 @@ auto mt::time::Time::nanoseconds() const -> std::chrono::nanoseconds {
     return m_nanoseconds_since_day_start - this->hours() - this->minutes() - this->seconds() - this->milliseconds() - this->microseconds();
 }
 
-auto mt::time::Time::localTime() -> mt::time::Time {
+auto mt::time::Time::localTime() -> mt::time::Time { return mt::time::Time(mt::localOffset()); }
+
+auto mt::time::Time::now(const ClockSource p_clock, const TimeZone p_time_zone) noexcept -> Time {
+    const auto time_point = mt::currentTime(p_clock) + std::chrono::hours{static_cast< int8_t >(p_time_zone)};
+    return Time{time_point - std::chrono::floor< std::chrono::days >(time_point), p_time_zone};
+}
 
-    const auto tm = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-    const auto offset = std::localtime(&tm)->tm_gmtoff;
+auto mt::time::Time::toString() const -> std::string { return toString(mt::iso_time_pattern); }
 
-    return mt::time::Time(static_cast< mt::TimeZone >(offset / 3600));
+auto mt::time::Time::toString(const FormatPattern& p_pattern) const -> std::string {
+    if (p_pattern.usesDate()) {
+        throw std::invalid_argument("Format pattern with date specifiers can not be applied to Time");
+    }
+    mt::instrumentation::count(mt::instrumentation::Counter::StringAllocations);
+    std::string result(p_pattern.maxLength(), '\0');
+    const auto [end, error] = p_pattern.format(result.data(), result.data() + result.size(), std::chrono::year_month_day{}, m_nanoseconds_since_day_start, utcOffset());
+    result.resize(static_cast< std::size_t >(end - result.data()));
+    return result;
 }
 
-//
-std::string mt::time::Time::toString(const std::function< std::string(const Time&) >& formatter) const {
+auto mt::time::Time::toString(const std::function< std::string(const Time&) >& formatter) const -> std::string {
     if (formatter) {
         return formatter(*this);
     }
-#if defined __cpp_lib_format
-    return std::format("{0:%T}{1}", *this, m_offset);
-#else
-    std::string time;
-    const auto hours = hours().count();
-    if (hours < 10) {
-        time += '0';
-    }
-    time += std::to_string(hours);
-    time += ':';
-    const auto minutes = minutes().count();
-    if (minutes < 10) {
-        time += '0';
-    }
-    time += std::to_string(minutes);
-    time += ':';
-    const auto seconds = seconds().count();
-    if (seconds < 10) {
-        time += '0';
-    }
-    time += std::to_string(seconds);
-    time += '.';
-    const auto nanoseconds = (m_nanoseconds_since_day_start - std::chrono::duration_cast< std::chrono::seconds >(m_nanoseconds_since_day_start)).count();
-    time += std::to_string(nanoseconds);
-    if (m_offset == mt::TimeZone::UTC) {
-        time += 'Z';
-    } else {
-        m_offset > mt::TimeZone::UTC ? time += '+' : time += '-';
-        if (m_offset > mt::TimeZone::WEST_10 && m_offset < mt::TimeZone::EAST_10) {
-            time += "0";
-        }
-        time += std::to_string(std::abs(static_cast< int8_t >(m_offset)));
-        time += ":00";
+    return toString();
+}
+
+auto mt::time::Time::toChars(char* const p_first, char* const p_last) const noexcept -> std::to_chars_result {
+    return mt::iso_time_pattern.format(p_first, p_last, std::chrono::year_month_day{}, m_nanoseconds_since_day_start, utcOffset());
+}
+
+auto mt::time::Time::toChars(char* const p_first, char* const p_last, const FormatPattern& p_pattern) const noexcept -> std::to_chars_result {
+    if (p_pattern.usesDate()) {
+        return {p_first, std::errc::invalid_argument};
     }
-    return time;
-#endif
+    return p_pattern.format(p_first, p_last, std::chrono::year_month_day{}, m_nanoseconds_since_day_start, utcOffset());
 }
 
 bool mt::time::operator!=(const mt::time::Time& l, const mt::time::Time& r) { return not(l == r); }
@@ -311,8 +316,9 @@ mt::time::Time mt::time::operator-(Time p_time, const TimeDuration p_value) {
 }
 
 auto mt::time::operator<<(std::ostream& out, const Time& time) -> std::ostream& {
-    const auto& _string = time.toString();
-    out.write(_string.data(), std::ssize(_string));
+    std::array< char, Time::max_string_length > buffer;
+    const auto [end, error] = time.toChars(buffer.data(), buffer.data() + buffer.size());
+    out.write(buffer.data(), end - buffer.data());
     return out;
 }
 
@@ -0,0 +1,64 @@
+#include "time_zones.hpp"
+#include "instrumentation.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+
+namespace {
+    /**
+     * \brief Cached offset packed with its validity: seconds since epoch the offset is valid until in high 56 bits, offset in low 8 bits.
+     * Zero means offset is not resolved yet.
+     */
+    std::atomic< uint64_t > cached_offset{0};
+
+    /**
+     * \brief Maximal distance the validity window is extended for.
+     */
+    constexpr int64_t horizon{24 * 60 * 60};
+
+    auto offsetAt(std::time_t p_time) noexcept -> long;
+    auto resolve(int64_t p_now) noexcept -> uint64_t;
+}  // End of unnamed namespace
+
+auto mt::localOffset() noexcept -> TimeZone {
+    const auto now = std::chrono::duration_cast< std::chrono::seconds >(std::chrono::system_clock::now().time_since_epoch()).count();
+    auto packed = cached_offset.load(std::memory_order_acquire);
+    if (static_cast< int64_t >(packed >> 8) <= now) {
+        // Concurrent refreshes resolve the same value, so the last store wins without harm.
+        packed = resolve(now);
+        cached_offset.store(packed, std::memory_order_release);
+    }
+    return static_cast< TimeZone >(static_cast< int8_t >(packed & 0xFF));
+}
+
+void mt::refreshLocalOffset() noexcept { cached_offset.store(0, std::memory_order_release); }
+
+namespace {
+    auto offsetAt(const std::time_t p_time) noexcept -> long {
+        mt::instrumentation::count(mt::instrumentation::Counter::LocaltimeCalls);
+        std::tm tm{};
+        if (localtime_r(&p_time, &tm) == nullptr) {
+            return 0;
+        }
+        return tm.tm_gmtoff;
+    }
+
+    auto resolve(const int64_t p_now) noexcept -> uint64_t {
+        const auto offset = offsetAt(p_now);
+        auto valid_until = p_now + horizon;
+        if (offsetAt(valid_until) != offset) {
+            // Binary search of the first second with the other offset.
+            auto first = p_now;
+            while (valid_until - first > 1) {
+                const auto middle = first + (valid_until - first) / 2;
+                if (offsetAt(middle) == offset) {
+                    first = middle;
+                } else {
+                    valid_until = middle;
+                }
+            }
+        }
+        return static_cast< uint64_t >(valid_until) << 8 | static_cast< uint8_t >(static_cast< int8_t >(mt::toTimeZone(std::chrono::seconds{offset})));
+    }
+}  // End of unnamed namespace
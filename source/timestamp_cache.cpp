@@ -0,0 +1,65 @@
+#include "timestamp_cache.hpp"
+
+mt::date_time::TimestampCache::TimestampCache(const TimeZone p_time_zone) noexcept :
+    m_time_zone(p_time_zone) { }
+
+auto mt::date_time::TimestampCache::format(const DateTime& p_date_time) noexcept -> std::string_view {
+    const auto date = p_date_time.date().date();
+    const auto since_day_start = p_date_time.time().sinceDayStart();
+    const auto offset = p_date_time.time().utcOffset();
+    if (date == m_date && std::chrono::floor< std::chrono::seconds >(since_day_start) == m_seconds && offset == m_offset) {
+        return patch(since_day_start);
+    }
+    return render(date, since_day_start, offset);
+}
+
+auto mt::date_time::TimestampCache::now() noexcept -> std::string_view {
+    const auto utc = std::chrono::time_point_cast< std::chrono::nanoseconds >(std::chrono::system_clock::now());
+    std::chrono::seconds offset{std::chrono::hours{static_cast< int8_t >(m_time_zone)}};
+    auto time_point = utc + offset;
+    auto days = std::chrono::floor< std::chrono::days >(time_point);
+    auto since_day_start = time_point - days;
+    // Civil date is only recomputed when the cached second is left.
+    if (std::chrono::floor< std::chrono::seconds >(since_day_start) == m_seconds && m_offset == offset
+        && std::chrono::sys_days{m_date} == days) {
+        return patch(since_day_start);
+    }
+    if (const auto local = m_follows_local ? mt::localOffset() : m_time_zone; local != m_time_zone) {
+        // Local offset has changed, e.g. on daylight saving transition, so the time point is shifted by the new one.
+        m_time_zone = local;
+        offset = std::chrono::hours{static_cast< int8_t >(m_time_zone)};
+        time_point = utc + offset;
+        days = std::chrono::floor< std::chrono::days >(time_point);
+        since_day_start = time_point - days;
+    }
+    return render(std::chrono::year_month_day{days}, since_day_start, offset);
+}
+
+auto mt::date_time::TimestampCache::local() -> TimestampCache& {
+    thread_local TimestampCache cache = [] {
+        TimestampCache result{mt::localOffset()};
+        result.m_follows_local = true;
+        return result;
+    }();
+    return cache;
+}
+
+auto mt::date_time::TimestampCache::render(const std::chrono::year_month_day p_date, const std::chrono::nanoseconds p_since_day_start, const std::chrono::seconds p_offset) noexcept
+    -> std::string_view {
+    const auto [end, error] = mt::iso_date_time_pattern.format(m_buffer.data(), m_buffer.data() + m_buffer.size(), p_date, p_since_day_start, p_offset);
+    m_length = static_cast< std::size_t >(end - m_buffer.data());
+    m_fraction_position = m_length - (p_offset == std::chrono::seconds{0} ? 1 : 6) - 9;
+    m_date = p_date;
+    m_seconds = std::chrono::floor< std::chrono::seconds >(p_since_day_start);
+    m_offset = p_offset;
+    return {m_buffer.data(), m_length};
+}
+
+auto mt::date_time::TimestampCache::patch(const std::chrono::nanoseconds p_since_day_start) noexcept -> std::string_view {
+    auto fraction = static_cast< uint32_t >((p_since_day_start - m_seconds).count());
+    for (auto* position = m_buffer.data() + m_fraction_position + 9; position != m_buffer.data() + m_fraction_position;) {
+        *--position = static_cast< char >('0' + fraction % 10);
+        fraction /= 10;
+    }
+    return {m_buffer.data(), m_length};
+}
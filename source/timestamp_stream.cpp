@@ -0,0 +1,213 @@
+#include "timestamp_stream.hpp"
+#include "instruction_set.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define MT_STREAM_X86_SIMD
+  #include <immintrin.h>
+#endif
+
+namespace {
+    /**
+     * \brief Payload widths of prefix codes [0], [10], [110], [1110] and [1111].
+     */
+    constexpr std::array< std::size_t, 5 > code_widths{0, 8, 16, 32, 64};
+
+    auto zigzag(uint64_t p_value) noexcept -> uint64_t;
+    auto unzigzag(uint64_t p_value) noexcept -> uint64_t;
+    /**
+     * \brief Returns 64 bits starting at p_position. Bit vector should have a word after the last used one.
+     */
+    auto peek(const uint64_t* p_bits, std::size_t p_position) noexcept -> uint64_t;
+    /**
+     * \brief Replaces each of p_size values with sum of it and all values before it, p_carry is added to each of them.
+     */
+    void prefixSumScalar(uint64_t* p_values, std::size_t p_size, uint64_t p_carry) noexcept;
+#if defined MT_STREAM_X86_SIMD
+    __attribute__((target("avx2"))) void prefixSumAVX2(uint64_t* p_values, std::size_t p_size, uint64_t p_carry) noexcept;
+#endif
+}  // End of unnamed namespace
+
+mt::batch::TimestampStream::TimestampStream(const std::span< const int64_t > p_epoch_nanoseconds) {
+    for (const auto value: p_epoch_nanoseconds) {
+        append(value);
+    }
+}
+
+void mt::batch::TimestampStream::append(const int64_t p_epoch_nanoseconds) {
+    if (m_size % block_rows == 0) {
+        m_blocks.push_back(Block{p_epoch_nanoseconds, m_bit_size});
+        m_last_delta = 0;
+    } else {
+        // Arithmetic is modular, so differences of any two values are restored exactly.
+        const auto delta = static_cast< uint64_t >(p_epoch_nanoseconds) - static_cast< uint64_t >(m_last);
+        const auto value = zigzag(delta - static_cast< uint64_t >(m_last_delta));
+        const auto width = std::bit_width(value);
+        if (value == 0) {
+            write(0, 1);
+        } else if (width <= 8) {
+            write(0b01 | (value << 2), 2 + 8);
+        } else if (width <= 16) {
+            write(0b011 | (value << 3), 3 + 16);
+        } else if (width <= 32) {
+            write(0b0111 | (value << 4), 4 + 32);
+        } else {
+            write(0b1111, 4);
+            write(value, 64);
+        }
+        m_last_delta = static_cast< int64_t >(delta);
+    }
+    m_last = p_epoch_nanoseconds;
+    ++m_size;
+}
+
+void mt::batch::TimestampStream::append(const date_time::DateTime& p_date_time) { append(p_date_time.sinceEpoch().count()); }
+
+void mt::batch::TimestampStream::clear() noexcept {
+    m_blocks.clear();
+    m_bits.clear();
+    m_bit_size = 0;
+    m_size = 0;
+    m_last = 0;
+    m_last_delta = 0;
+}
+
+auto mt::batch::TimestampStream::bytes() const noexcept -> std::size_t { return m_bits.size() * sizeof(uint64_t) + m_blocks.size() * sizeof(Block); }
+
+auto mt::batch::TimestampStream::at(const std::size_t p_row) const -> int64_t {
+    checkRows(p_row, 1);
+    std::array< int64_t, block_rows > values;
+    decodeBlock(p_row / block_rows, p_row % block_rows + 1, values.data());
+    return values[p_row % block_rows];
+}
+
+void mt::batch::TimestampStream::decode(const std::size_t p_first, const std::span< int64_t > p_output) const {
+    checkRows(p_first, p_output.size());
+    std::array< int64_t, block_rows > values;
+    for (std::size_t row = p_first; row < p_first + p_output.size();) {
+        const auto block = row / block_rows;
+        const auto offset = row % block_rows;
+        const auto rows = std::min(block_rows - offset, p_first + p_output.size() - row);
+        auto* const output = p_output.data() + (row - p_first);
+        if (offset == 0) {
+            decodeBlock(block, rows, output);
+        } else {
+            decodeBlock(block, offset + rows, values.data());
+            std::copy_n(values.data() + offset, rows, output);
+        }
+        row += rows;
+    }
+}
+
+void mt::batch::TimestampStream::decode(const std::size_t p_first, const std::span< date_time::DateTime > p_output, const TimeZone p_time_zone) const {
+    checkRows(p_first, p_output.size());
+    std::array< int64_t, block_rows > values;
+    for (std::size_t row = 0; row < p_output.size(); row += block_rows) {
+        const auto rows = std::min(block_rows, p_output.size() - row);
+        decode(p_first + row, std::span{values}.first(rows));
+        for (std::size_t i = 0; i < rows; ++i) {
+            p_output[row + i] = date_time::DateTime{std::chrono::nanoseconds{values[i]}, p_time_zone};
+        }
+    }
+}
+
+void mt::batch::TimestampStream::write(const uint64_t p_value, const std::size_t p_width) {
+    // One word is kept after the last used one, so peek never reads past the end.
+    m_bits.resize((m_bit_size + p_width) / 64 + 2, 0);
+    const auto word = m_bit_size / 64;
+    const auto shift = m_bit_size % 64;
+    m_bits[word] |= p_value << shift;
+    if (shift != 0 && shift + p_width > 64) {
+        m_bits[word + 1] |= p_value >> (64 - shift);
+    }
+    m_bit_size += p_width;
+}
+
+void mt::batch::TimestampStream::decodeBlock(const std::size_t p_block, const std::size_t p_rows, int64_t* const p_output) const noexcept {
+    auto* const values = reinterpret_cast< uint64_t* >(p_output);
+    // Row 0 is the block first value. Delta of row 0 is taken as 0, so delta of delta of row 1 is its delta.
+    values[0] = 0;
+    const uint64_t* const bits = m_bits.data();
+    auto position = m_blocks[p_block].bit_offset;
+    for (std::size_t row = 1; row < p_rows;) {
+        const auto window = peek(bits, position);
+        if ((window & 1) == 0) {
+            // Each zero bit is a row with delta of delta 0.
+            const auto zeros = std::min< std::size_t >(static_cast< std::size_t >(std::countr_zero(window)), p_rows - row);
+            std::fill_n(values + row, zeros, 0);
+            row += zeros;
+            position += zeros;
+            continue;
+        }
+        const auto ones = std::min(static_cast< std::size_t >(std::countr_one(window)), code_widths.size() - 1);
+        const auto width = code_widths[ones];
+        position += ones == code_widths.size() - 1 ? ones : ones + 1;
+        auto value = peek(bits, position);
+        if (width < 64) {
+            value &= (uint64_t{1} << width) - 1;
+        }
+        values[row++] = unzigzag(value);
+        position += width;
+    }
+    auto* prefix_sum = &prefixSumScalar;
+#if defined MT_STREAM_X86_SIMD
+    if (mt::supportedInstructionSet() >= mt::InstructionSet::AVX2) {
+        prefix_sum = &prefixSumAVX2;
+    }
+#endif
+    // Delta of deltas are summed into deltas, deltas starting from the first value are summed into values.
+    prefix_sum(values, p_rows, 0);
+    values[0] = static_cast< uint64_t >(m_blocks[p_block].first);
+    prefix_sum(values, p_rows, 0);
+}
+
+void mt::batch::TimestampStream::checkRows(const std::size_t p_first, const std::size_t p_count) const {
+    if (p_first > m_size || p_count > m_size - p_first) {
+        throw std::out_of_range("mt::batch::TimestampStream: rows [" + std::to_string(p_first) + ", " + std::to_string(p_first + p_count) + ") are requested, but stream has "
+                                + std::to_string(m_size) + " rows");
+    }
+}
+
+namespace {
+    auto zigzag(const uint64_t p_value) noexcept -> uint64_t { return (p_value << 1) ^ (0 - (p_value >> 63)); }
+
+    auto unzigzag(const uint64_t p_value) noexcept -> uint64_t { return (p_value >> 1) ^ (0 - (p_value & 1)); }
+
+    auto peek(const uint64_t* const p_bits, const std::size_t p_position) noexcept -> uint64_t {
+        const auto word = p_position / 64;
+        const auto shift = p_position % 64;
+        if (shift == 0) {
+            return p_bits[word];
+        }
+        return (p_bits[word] >> shift) | (p_bits[word + 1] << (64 - shift));
+    }
+
+    void prefixSumScalar(uint64_t* const p_values, const std::size_t p_size, uint64_t p_carry) noexcept {
+        for (std::size_t i = 0; i < p_size; ++i) {
+            p_carry += p_values[i];
+            p_values[i] = p_carry;
+        }
+    }
+
+#if defined MT_STREAM_X86_SIMD
+    __attribute__((target("avx2"))) void prefixSumAVX2(uint64_t* const p_values, const std::size_t p_size, const uint64_t p_carry) noexcept {
+        auto carry = _mm256_set1_epi64x(static_cast< long long >(p_carry));
+        std::size_t i = 0;
+        for (; i + 4 <= p_size; i += 4) {
+            auto sums = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(p_values + i));
+            // [a, b, c, d] -> [a, a + b, c, c + d] -> [a, a + b, a + b + c, a + b + c + d].
+            sums = _mm256_add_epi64(sums, _mm256_slli_si256(sums, 8));
+            sums = _mm256_add_epi64(sums, _mm256_blend_epi32(_mm256_permute4x64_epi64(sums, 0b01'01'00'00), _mm256_setzero_si256(), 0x0F));
+            sums = _mm256_add_epi64(sums, carry);
+            _mm256_storeu_si256(reinterpret_cast< __m256i* >(p_values + i), sums);
+            carry = _mm256_permute4x64_epi64(sums, 0b11'11'11'11);
+        }
+        prefixSumScalar(p_values + i, p_size - i, i == 0 ? p_carry : p_values[i - 1]);
+    }
+#endif
+}  // End of unnamed namespace
@@ -0,0 +1,114 @@
+#include "zone_conversion.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    constexpr int64_t nanoseconds_per_second{1'000'000'000};
+    constexpr int64_t nanoseconds_per_day{86'400 * nanoseconds_per_second};
+    constexpr int64_t seconds_per_day{86'400};
+    constexpr int64_t min_time{std::numeric_limits< int64_t >::min()};
+    constexpr int64_t max_time{std::numeric_limits< int64_t >::max()};
+
+    void checkOutput(std::size_t p_rows, std::size_t p_output_size);
+    auto floorDivide(int64_t p_value, int64_t p_divisor) noexcept -> int64_t;
+    void localize(const mt::Zone& p_zone, mt::ZoneId p_zone_id, std::span< const int64_t > p_input, std::span< mt::date_time::DateTime > p_output);
+    void globalize(const mt::Zone& p_zone, std::span< const mt::date_time::DateTime > p_input, std::span< int64_t > p_output, mt::Choose p_choose);
+}  // End of unnamed namespace
+
+void mt::batch::toLocal(const std::span< const int64_t > p_epoch_nanoseconds, const ZoneId p_zone, const std::span< date_time::DateTime > p_output) {
+    checkOutput(p_epoch_nanoseconds.size(), p_output.size());
+    localize(ZoneDatabase::zone(p_zone), p_zone, p_epoch_nanoseconds, p_output);
+}
+
+void mt::batch::toLocal(Executor& p_executor, const std::span< const int64_t > p_epoch_nanoseconds, const ZoneId p_zone, const std::span< date_time::DateTime > p_output) {
+    checkOutput(p_epoch_nanoseconds.size(), p_output.size());
+    const auto& zone = ZoneDatabase::zone(p_zone);
+    p_executor.forEachChunk(p_epoch_nanoseconds.size(), [&](const std::size_t p_first, const std::size_t p_last) {
+        localize(zone, p_zone, p_epoch_nanoseconds.subspan(p_first, p_last - p_first), p_output.subspan(p_first, p_last - p_first));
+    });
+}
+
+void mt::batch::toUtc(const std::span< const date_time::DateTime > p_local, const ZoneId p_zone, const std::span< int64_t > p_epoch_nanoseconds, const Choose p_choose) {
+    checkOutput(p_local.size(), p_epoch_nanoseconds.size());
+    globalize(ZoneDatabase::zone(p_zone), p_local, p_epoch_nanoseconds, p_choose);
+}
+
+void mt::batch::toUtc(Executor& p_executor,
+                      const std::span< const date_time::DateTime > p_local,
+                      const ZoneId p_zone,
+                      const std::span< int64_t > p_epoch_nanoseconds,
+                      const Choose p_choose) {
+    checkOutput(p_local.size(), p_epoch_nanoseconds.size());
+    const auto& zone = ZoneDatabase::zone(p_zone);
+    p_executor.forEachChunk(p_local.size(), [&](const std::size_t p_first, const std::size_t p_last) {
+        globalize(zone, p_local.subspan(p_first, p_last - p_first), p_epoch_nanoseconds.subspan(p_first, p_last - p_first), p_choose);
+    });
+}
+
+namespace {
+    void checkOutput(const std::size_t p_rows, const std::size_t p_output_size) {
+        if (p_output_size != p_rows) {
+            throw std::invalid_argument("mt::batch: [output] column has " + std::to_string(p_output_size) + " rows, but " + std::to_string(p_rows)
+                                        + " rows are expected");
+        }
+    }
+
+    auto floorDivide(const int64_t p_value, const int64_t p_divisor) noexcept -> int64_t {
+        return p_value / p_divisor - static_cast< int64_t >(p_value % p_divisor < 0);
+    }
+
+    void localize(const mt::Zone& p_zone, const mt::ZoneId p_zone_id, const std::span< const int64_t > p_input, const std::span< mt::date_time::DateTime > p_output) {
+        // Empty interval, so the first row always looks the period up.
+        mt::Zone::Period period{1, 0, 0};
+        for (std::size_t i = 0; i < p_input.size(); ++i) {
+            const auto nanoseconds = p_input[i];
+            const auto seconds = floorDivide(nanoseconds, nanoseconds_per_second);
+            if (seconds < period.begin || seconds >= period.end) {
+                period = p_zone.period(std::chrono::sys_seconds{std::chrono::seconds{seconds}});
+            }
+            auto days = floorDivide(nanoseconds, nanoseconds_per_day);
+            // Offset is added to time of the day, so the value can not overflow at the ends of the range.
+            auto since_day_start = nanoseconds - days * nanoseconds_per_day + period.offset * nanoseconds_per_second;
+            if (since_day_start < 0) {
+                since_day_start += nanoseconds_per_day;
+                --days;
+            } else if (since_day_start >= nanoseconds_per_day) {
+                since_day_start -= nanoseconds_per_day;
+                ++days;
+            }
+            p_output[i] = mt::date_time::DateTime{mt::date::Date{std::chrono::sys_days{std::chrono::days{days}}},
+                                                  mt::time::Time{std::chrono::nanoseconds{since_day_start}, std::chrono::seconds{period.offset}, p_zone_id}};
+        }
+    }
+
+    void globalize(const mt::Zone& p_zone, const std::span< const mt::date_time::DateTime > p_input, const std::span< int64_t > p_output, const mt::Choose p_choose) {
+        // Local times [local_begin, local_end) are converted with offset, empty at first so the first row always resolves it.
+        int64_t local_begin{1};
+        int64_t local_end{0};
+        int64_t offset{0};
+        for (std::size_t i = 0; i < p_input.size(); ++i) {
+            const auto since_day_start = p_input[i].time().sinceDayStart();
+            const auto whole_seconds = std::chrono::floor< std::chrono::seconds >(since_day_start);
+            const auto local = p_input[i].date().sinceEpoch().time_since_epoch().count() * seconds_per_day + whole_seconds.count();
+            if (local < local_begin || local >= local_end) {
+                offset = p_zone.resolve(std::chrono::local_seconds{std::chrono::seconds{local}}, p_choose).count();
+                const auto period = p_zone.period(std::chrono::sys_seconds{std::chrono::seconds{local - offset}});
+                if (period.offset == offset) {
+                    // Local times next to transitions happen twice or never, those are resolved one by one.
+                    const auto previous = period.begin == min_time ? offset : p_zone.period(std::chrono::sys_seconds{std::chrono::seconds{period.begin - 1}}).offset;
+                    const auto next = period.end == max_time ? offset : p_zone.period(std::chrono::sys_seconds{std::chrono::seconds{period.end}}).offset;
+                    local_begin = period.begin == min_time ? min_time : period.begin + std::max< int64_t >(offset, previous);
+                    local_end = period.end == max_time ? max_time : period.end + std::min< int64_t >(offset, next);
+                } else {
+                    local_begin = 1;
+                    local_end = 0;
+                }
+            }
+            p_output[i] = (local - offset) * nanoseconds_per_second + (since_day_start - whole_seconds).count();
+        }
+    }
+}  // End of unnamed namespace
@@ -0,0 +1,458 @@
+#include "zone_database.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    constexpr std::size_t header_length{44};
+    constexpr int64_t seconds_per_day{86'400};
+    constexpr int64_t min_time{std::numeric_limits< int64_t >::min()};
+    constexpr int64_t max_time{std::numeric_limits< int64_t >::max()};
+
+    /**
+     * \brief Counts stored in TZif header, in the order they appear in it.
+     */
+    struct Counts {
+        std::size_t utc_indicators;
+        std::size_t standard_indicators;
+        std::size_t leap_seconds;
+        std::size_t times;
+        std::size_t types;
+        std::size_t characters;
+    };
+
+    struct Registry {
+        Registry();
+
+        std::mutex mutex;
+        std::unordered_map< std::string, mt::ZoneId > ids;
+        std::vector< std::unique_ptr< mt::Zone > > zones;
+        std::filesystem::path directory;
+    };
+
+    /**
+     * \brief Loaded zones by ZoneId - 1. Published once and never changed, so may be read without lock.
+     */
+    std::array< std::atomic< const mt::Zone* >, mt::ZoneDatabase::max_zones > loaded_zones{};
+
+    auto registry() -> Registry&;
+    auto load32(const std::byte* p_data) noexcept -> uint32_t;
+    auto load64(const std::byte* p_data) noexcept -> uint64_t;
+    auto readCounts(const std::byte* p_header) noexcept -> Counts;
+    auto parseName(std::string_view& p_text) noexcept -> bool;
+    auto parseNumber(std::string_view& p_text, int32_t p_max) noexcept -> std::optional< int32_t >;
+    auto parseDuration(std::string_view& p_text, int32_t p_max_hours) noexcept -> std::optional< int32_t >;
+}  // End of unnamed namespace
+
+mt::Zone::Zone(std::string p_name, const std::filesystem::path& p_path) :
+    m_name(std::move(p_name)) {
+    const auto descriptor = ::open(p_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) {
+        throw std::invalid_argument("mt::Zone: zone file " + p_path.string() + " can not be opened");
+    }
+    struct stat status{};
+    void* data = MAP_FAILED;
+    if (::fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+        m_size = static_cast< std::size_t >(status.st_size);
+        data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    }
+    ::close(descriptor);
+    if (data == MAP_FAILED) {
+        throw std::invalid_argument("mt::Zone: zone file " + p_path.string() + " can not be mapped");
+    }
+    m_data = static_cast< const std::byte* >(data);
+    try {
+        parse();
+    } catch (...) {
+        ::munmap(const_cast< std::byte* >(m_data), m_size);
+        throw;
+    }
+}
+
+mt::Zone::~Zone() { ::munmap(const_cast< std::byte* >(m_data), m_size); }
+
+auto mt::Zone::offset(const std::chrono::sys_seconds p_time) const noexcept -> std::chrono::seconds { return std::chrono::seconds{period(p_time).offset}; }
+
+auto mt::Zone::period(const std::chrono::sys_seconds p_time) const noexcept -> Period {
+    const auto time = p_time.time_since_epoch().count();
+    if (m_time_count == 0) {
+        return m_has_rule ? rulePeriod(time, min_time) : Period{min_time, max_time, typeOffset(0)};
+    }
+    if (time < transition(0)) {
+        return Period{min_time, transition(0), typeOffset(0)};
+    }
+    // Index of the last transition which is not later than time.
+    std::size_t first = 0;
+    std::size_t count = m_time_count;
+    while (count > 1) {
+        const auto half = count / 2;
+        if (transition(first + half) <= time) {
+            first += half;
+            count -= half;
+        } else {
+            count = half;
+        }
+    }
+    if (first == m_time_count - 1) {
+        return m_has_rule ? rulePeriod(time, transition(first)) : Period{transition(first), max_time, typeOffset(std::to_integer< std::size_t >(m_types[first]))};
+    }
+    return Period{transition(first), transition(first + 1), typeOffset(std::to_integer< std::size_t >(m_types[first]))};
+}
+
+auto mt::Zone::resolve(const std::chrono::local_seconds p_time, const Choose p_choose) const noexcept -> std::chrono::seconds {
+    const auto time = p_time.time_since_epoch();
+    // Transitions are never closer than two days, so offsets a day before and a day after are the only candidates.
+    const auto before = offset(std::chrono::sys_seconds{time - std::chrono::days{1}});
+    const auto after = offset(std::chrono::sys_seconds{time + std::chrono::days{1}});
+    if (before == after) {
+        return before;
+    }
+    const auto before_valid = offset(std::chrono::sys_seconds{time - before}) == before;
+    const auto after_valid = offset(std::chrono::sys_seconds{time - after}) == after;
+    if (before_valid && after_valid) {
+        // The larger offset gives the earlier instant.
+        return p_choose == Choose::Earliest ? std::max(before, after) : std::min(before, after);
+    }
+    return after_valid ? after : before;
+}
+
+void mt::Zone::parse() {
+    if (m_size < header_length || std::memcmp(m_data, "TZif", 4) != 0) {
+        throw std::invalid_argument("mt::Zone: " + m_name + " is not a TZif file");
+    }
+    if (std::to_integer< char >(m_data[4]) < '2') {
+        throw std::invalid_argument("mt::Zone: " + m_name + " TZif version 1 is not supported");
+    }
+    // Version 1 data block, which uses 32 bit times, is skipped in favor of the 64 bit block which follows it.
+    const auto legacy = readCounts(m_data);
+    const auto legacy_length = legacy.times * 5 + legacy.types * 6 + legacy.characters + legacy.leap_seconds * 8 + legacy.standard_indicators + legacy.utc_indicators;
+    const auto* const header = m_data + header_length + legacy_length;
+    if (header + header_length > m_data + m_size || std::memcmp(header, "TZif", 4) != 0) {
+        throw std::invalid_argument("mt::Zone: " + m_name + " TZif file is truncated");
+    }
+    const auto counts = readCounts(header);
+    const auto length = counts.times * 9 + counts.types * 6 + counts.characters + counts.leap_seconds * 12 + counts.standard_indicators + counts.utc_indicators;
+    if (counts.types == 0 || header + header_length + length > m_data + m_size) {
+        throw std::invalid_argument("mt::Zone: " + m_name + " TZif file is truncated");
+    }
+    m_time_count = counts.times;
+    m_times = header + header_length;
+    m_types = m_times + counts.times * 8;
+    m_infos = m_types + counts.times;
+    for (std::size_t i = 0; i < m_time_count; ++i) {
+        if (std::to_integer< std::size_t >(m_types[i]) >= counts.types) {
+            throw std::invalid_argument("mt::Zone: " + m_name + " TZif file refers to missing time type");
+        }
+    }
+    const auto* const footer = reinterpret_cast< const char* >(header + header_length + length);
+    const std::string_view rest{footer, static_cast< std::size_t >(reinterpret_cast< const char* >(m_data + m_size) - footer)};
+    if (rest.size() > 1 && rest.front() == '\n') {
+        if (const auto end = rest.find('\n', 1); end != std::string_view::npos) {
+            parseRule(rest.substr(1, end - 1));
+        }
+    }
+}
+
+void mt::Zone::parseRule(std::string_view p_rule) {
+    // Footer which can not be parsed is ignored, so the last transition stays in effect.
+    if (p_rule.empty() || not parseName(p_rule)) {
+        return;
+    }
+    // POSIX offsets are positive to the west of Greenwich.
+    const auto standard = parseDuration(p_rule, 24);
+    if (not standard) {
+        return;
+    }
+    m_std_offset = -*standard;
+    m_dst_offset = m_std_offset + 3600;
+    if (p_rule.empty()) {
+        m_has_rule = true;
+        return;
+    }
+    if (not parseName(p_rule)) {
+        return;
+    }
+    if (not p_rule.empty() && p_rule.front() != ',') {
+        const auto daylight = parseDuration(p_rule, 24);
+        if (not daylight) {
+            return;
+        }
+        m_dst_offset = -*daylight;
+    }
+    if (p_rule.empty()) {
+        // Rule of the United States is used when transition dates are not provided.
+        p_rule = ",M3.2.0,M11.1.0";
+    }
+    for (auto* date: {&m_dst_start, &m_dst_end}) {
+        if (p_rule.empty() || p_rule.front() != ',') {
+            return;
+        }
+        p_rule.remove_prefix(1);
+        if (p_rule.empty()) {
+            return;
+        }
+        date->kind = p_rule.front();
+        if (date->kind == 'M') {
+            p_rule.remove_prefix(1);
+            const auto month = parseNumber(p_rule, 12);
+            if (not month || *month < 1 || p_rule.empty() || p_rule.front() != '.') {
+                return;
+            }
+            p_rule.remove_prefix(1);
+            const auto week = parseNumber(p_rule, 5);
+            if (not week || *week < 1 || p_rule.empty() || p_rule.front() != '.') {
+                return;
+            }
+            p_rule.remove_prefix(1);
+            const auto day = parseNumber(p_rule, 6);
+            if (not day) {
+                return;
+            }
+            date->month = static_cast< uint8_t >(*month);
+            date->week = static_cast< uint8_t >(*week);
+            date->day = static_cast< uint16_t >(*day);
+        } else {
+            if (date->kind == 'J') {
+                p_rule.remove_prefix(1);
+            } else {
+                date->kind = 'D';
+            }
+            const auto day = parseNumber(p_rule, 365);
+            if (not day || (date->kind == 'J' && *day < 1)) {
+                return;
+            }
+            date->day = static_cast< uint16_t >(*day);
+        }
+        if (not p_rule.empty() && p_rule.front() == '/') {
+            p_rule.remove_prefix(1);
+            // TZif extends POSIX with transition times from -167 to 167 hours.
+            const auto time = parseDuration(p_rule, 167);
+            if (not time) {
+                return;
+            }
+            date->time = *time;
+        }
+    }
+    m_has_rule = p_rule.empty();
+    m_has_dst = m_has_rule;
+}
+
+auto mt::Zone::transition(const std::size_t p_index) const noexcept -> int64_t { return static_cast< int64_t >(load64(m_times + p_index * 8)); }
+
+auto mt::Zone::typeOffset(const std::size_t p_type) const noexcept -> int32_t { return static_cast< int32_t >(load32(m_infos + p_type * 6)); }
+
+auto mt::Zone::rulePeriod(const int64_t p_time, const int64_t p_rule_start) const noexcept -> Period {
+    if (not m_has_dst) {
+        return Period{p_rule_start, max_time, m_std_offset};
+    }
+    const auto local_day = std::chrono::sys_days{std::chrono::floor< std::chrono::days >(std::chrono::seconds{p_time + m_std_offset})};
+    const auto year = static_cast< int32_t >(std::chrono::year_month_day{local_day}.year());
+    const auto start = ruleTransition(year, m_dst_start, m_std_offset);
+    const auto end = ruleTransition(year, m_dst_end, m_dst_offset);
+    Period result{};
+    if (start < end) {
+        if (p_time < start) {
+            result = Period{ruleTransition(year - 1, m_dst_end, m_dst_offset), start, m_std_offset};
+        } else if (p_time < end) {
+            result = Period{start, end, m_dst_offset};
+        } else {
+            result = Period{end, ruleTransition(year + 1, m_dst_start, m_std_offset), m_std_offset};
+        }
+    } else {
+        // Daylight saving time of the southern hemisphere spans the end of the year.
+        if (p_time < end) {
+            result = Period{ruleTransition(year - 1, m_dst_start, m_std_offset), end, m_dst_offset};
+        } else if (p_time < start) {
+            result = Period{end, start, m_std_offset};
+        } else {
+            result = Period{start, ruleTransition(year + 1, m_dst_end, m_dst_offset), m_dst_offset};
+        }
+    }
+    result.begin = std::max(result.begin, p_rule_start);
+    return result;
+}
+
+auto mt::Zone::ruleTransition(const int32_t p_year, const RuleDate& p_date, const int32_t p_offset) const noexcept -> int64_t {
+    const std::chrono::year year{p_year};
+    std::chrono::sys_days day{};
+    switch (p_date.kind) {
+        case 'J': {
+            // Julian day 1 to 365 never counts February 29.
+            day = std::chrono::sys_days{year / std::chrono::January / 1} + std::chrono::days{p_date.day - 1 + (year.is_leap() && p_date.day >= 60 ? 1 : 0)};
+            break;
+        }
+        case 'D': {
+            day = std::chrono::sys_days{year / std::chrono::January / 1} + std::chrono::days{p_date.day};
+            break;
+        }
+        default: {
+            const std::chrono::month month{p_date.month};
+            const std::chrono::weekday week_day{p_date.day};
+            if (p_date.week == 5) {
+                day = std::chrono::sys_days{year / month / week_day[std::chrono::last]};
+            } else {
+                day = std::chrono::sys_days{year / month / week_day[p_date.week]};
+            }
+            break;
+        }
+    }
+    return day.time_since_epoch().count() * seconds_per_day + p_date.time - p_offset;
+}
+
+auto mt::ZoneDatabase::locate(const std::string_view p_name) -> ZoneId {
+    const std::filesystem::path relative{p_name};
+    if (p_name.empty() || relative.is_absolute() || std::ranges::any_of(relative, [](const auto& p_part) { return p_part == ".."; })) {
+        throw std::invalid_argument("mt::ZoneDatabase: bad [zone] name " + std::string{p_name});
+    }
+    auto& instance = registry();
+    const std::scoped_lock lock{instance.mutex};
+    std::string name{p_name};
+    if (const auto found = instance.ids.find(name); found != instance.ids.end()) {
+        return found->second;
+    }
+    if (instance.zones.size() == max_zones) {
+        throw std::length_error("mt::ZoneDatabase: too many zones are loaded");
+    }
+    auto zone = std::make_unique< Zone >(name, instance.directory / relative);
+    const auto id = static_cast< ZoneId >(instance.zones.size() + 1);
+    loaded_zones[instance.zones.size()].store(zone.get(), std::memory_order_release);
+    instance.zones.push_back(std::move(zone));
+    instance.ids.emplace(std::move(name), id);
+    return id;
+}
+
+auto mt::ZoneDatabase::zone(const ZoneId p_zone) -> const Zone& {
+    const auto index = static_cast< std::size_t >(p_zone);
+    const Zone* zone = nullptr;
+    if (index != 0 && index <= max_zones) {
+        zone = loaded_zones[index - 1].load(std::memory_order_acquire);
+    }
+    if (zone == nullptr) {
+        throw std::out_of_range("mt::ZoneDatabase: zone " + std::to_string(index) + " is not loaded");
+    }
+    return *zone;
+}
+
+void mt::ZoneDatabase::setDirectory(std::filesystem::path p_directory) {
+    auto& instance = registry();
+    const std::scoped_lock lock{instance.mutex};
+    instance.directory = std::move(p_directory);
+}
+
+auto mt::ZoneDatabase::directory() -> std::filesystem::path {
+    auto& instance = registry();
+    const std::scoped_lock lock{instance.mutex};
+    return instance.directory;
+}
+
+namespace {
+    auto registry() -> Registry& {
+        static Registry instance;
+        return instance;
+    }
+
+    Registry::Registry() {
+        const auto* const zone_directory = std::getenv("TZDIR");
+        directory = zone_directory != nullptr && *zone_directory != '\0' ? zone_directory : "/usr/share/zoneinfo";
+    }
+
+    auto load32(const std::byte* const p_data) noexcept -> uint32_t {
+        uint32_t value{0};
+        std::memcpy(&value, p_data, sizeof(value));
+        if constexpr (std::endian::native == std::endian::little) {
+            value = std::byteswap(value);
+        }
+        return value;
+    }
+
+    auto load64(const std::byte* const p_data) noexcept -> uint64_t {
+        uint64_t value{0};
+        std::memcpy(&value, p_data, sizeof(value));
+        if constexpr (std::endian::native == std::endian::little) {
+            value = std::byteswap(value);
+        }
+        return value;
+    }
+
+    auto readCounts(const std::byte* const p_header) noexcept -> Counts {
+        const auto* const counts = p_header + 20;
+        return Counts{load32(counts), load32(counts + 4), load32(counts + 8), load32(counts + 12), load32(counts + 16), load32(counts + 20)};
+    }
+
+    auto parseName(std::string_view& p_text) noexcept -> bool {
+        std::size_t length = 0;
+        if (not p_text.empty() && p_text.front() == '<') {
+            length = p_text.find('>');
+            if (length == std::string_view::npos) {
+                return false;
+            }
+            ++length;
+        } else {
+            while (length < p_text.size() && ((p_text[length] >= 'A' && p_text[length] <= 'Z') || (p_text[length] >= 'a' && p_text[length] <= 'z'))) {
+                ++length;
+            }
+            if (length < 3) {
+                return false;
+            }
+        }
+        p_text.remove_prefix(length);
+        return true;
+    }
+
+    auto parseNumber(std::string_view& p_text, const int32_t p_max) noexcept -> std::optional< int32_t > {
+        int32_t value = 0;
+        std::size_t length = 0;
+        while (length < p_text.size() && p_text[length] >= '0' && p_text[length] <= '9') {
+            value = value * 10 + (p_text[length++] - '0');
+            if (value > p_max) {
+                return std::nullopt;
+            }
+        }
+        if (length == 0) {
+            return std::nullopt;
+        }
+        p_text.remove_prefix(length);
+        return value;
+    }
+
+    auto parseDuration(std::string_view& p_text, const int32_t p_max_hours) noexcept -> std::optional< int32_t > {
+        int32_t sign = 1;
+        if (not p_text.empty() && (p_text.front() == '+' || p_text.front() == '-')) {
+            sign = p_text.front() == '-' ? -1 : 1;
+            p_text.remove_prefix(1);
+        }
+        const auto hours = parseNumber(p_text, p_max_hours);
+        if (not hours) {
+            return std::nullopt;
+        }
+        int32_t seconds = *hours * 3600;
+        for (const int32_t multiplier: {60, 1}) {
+            if (p_text.empty() || p_text.front() != ':') {
+                break;
+            }
+            p_text.remove_prefix(1);
+            const auto value = parseNumber(p_text, 59);
+            if (not value) {
+                return std::nullopt;
+            }
+            seconds += *value * multiplier;
+        }
+        return sign * seconds;
+    }
+}  // End of unnamed namespace